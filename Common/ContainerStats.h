@@ -0,0 +1,235 @@
+#pragma once
+
+/**
+ * @file ContainerStats.h
+ * @brief Optional memory and operation counters shared by every container
+ *
+ * The counters are compiled in only when DS_ENABLE_STATS is defined
+ * (/D DS_ENABLE_STATS in Visual Studio, -DDS_ENABLE_STATS with g++).
+ * Without it every DS_STATS_* macro expands to nothing: the containers get
+ * no extra member, no accessor and no extra instructions.
+ *
+ * A container opts in with:
+ * - DS_STATS_MEMBER in its private section (the counters)
+ * - DS_STATS_ACCESSOR in its public section (get_stats())
+ * - DS_STATS_ALLOC(bytes) / DS_STATS_FREE(bytes) next to every node or buffer allocation
+ * - DS_STATS_MOVE_NODES(other, count, bytes) / DS_STATS_GIVE_NODES(other, count, bytes)
+ *   when nodes are relinked from / to another container
+ * - DS_STATS_OP("name") at the top of an operation, DS_STATS_STEP() per node it walks
+ *
+ * Like the containers themselves the counters are not thread-safe.
+ */
+
+#ifdef DS_ENABLE_STATS
+
+#include <cstddef>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Counters of one operation (e.g. "insert_sorted")
+ */
+struct OperationStats
+{
+	long long calls{};				///< Number of times the operation ran
+	long long nodes_traversed{};	///< Nodes (or elements) it walked in total
+};
+
+/**
+ * @brief Memory and per-operation counters of one container instance
+ */
+class ContainerStats {
+public:
+	long long live_nodes{};		///< Allocations not freed yet (nodes or buffers)
+	long long bytes{};			///< Bytes currently allocated
+	long long peak_bytes{};		///< Highest value bytes has reached
+	long long allocations{};	///< Total allocations
+	long long frees{};			///< Total frees
+
+private:
+	std::vector<OperationStats> operations;	///< Indexed by operation id
+
+	// Operation names are registered once per call site and shared by all containers
+	static std::vector<std::string>& operation_names() {
+		static std::vector<std::string> names;
+		return names;
+	}
+
+	static std::mutex& registry_lock() {
+		static std::mutex lock;
+		return lock;
+	}
+
+public:
+	/**
+	 * @brief Gets the id of an operation name, registering it on first use
+	 */
+	static int register_operation(const char* name) {
+		std::lock_guard<std::mutex> lock(registry_lock());
+		std::vector<std::string>& names = operation_names();
+		for (int id = 0; id < (int)names.size(); ++id)
+			if (names[id] == name)
+				return id;
+		names.push_back(name);
+		return (int)names.size() - 1;
+	}
+
+	/**
+	 * @brief Counts one allocation of the given size
+	 */
+	void on_alloc(std::size_t size) {
+		++live_nodes;
+		++allocations;
+		bytes += size;
+		if (bytes > peak_bytes)
+			peak_bytes = bytes;
+	}
+
+	/**
+	 * @brief Counts one free of the given size
+	 */
+	void on_free(std::size_t size) {
+		--live_nodes;
+		++frees;
+		bytes -= size;
+	}
+
+	/**
+	 * @brief Moves live nodes from another container without counting allocations
+	 *
+	 * Used when nodes are relinked from one container into another (merge,
+	 * append, split), so each container keeps reporting the memory it holds.
+	 */
+	void take_nodes(ContainerStats& from, long long count, std::size_t size) {
+		from.live_nodes -= count;
+		from.bytes -= count * (long long)size;
+		live_nodes += count;
+		bytes += count * (long long)size;
+		if (bytes > peak_bytes)
+			peak_bytes = bytes;
+	}
+
+	/**
+	 * @brief Counters of an operation id (created on demand)
+	 */
+	OperationStats& operation(int id) {
+		if (id >= (int)operations.size())
+			operations.resize(id + 1);
+		return operations[id];
+	}
+
+	/**
+	 * @brief Counters of an operation by name (zeros if it never ran)
+	 */
+	OperationStats operation(const std::string& name) const {
+		std::lock_guard<std::mutex> lock(registry_lock());
+		const std::vector<std::string>& names = operation_names();
+		for (int id = 0; id < (int)operations.size(); ++id)
+			if (names[id] == name)
+				return operations[id];
+		return OperationStats();
+	}
+
+	/**
+	 * @brief Adds the counters of a nested container (e.g. the rows of a matrix)
+	 *
+	 * Peaks are summed, which gives an upper bound of the combined peak.
+	 */
+	ContainerStats& operator+=(const ContainerStats& other) {
+		live_nodes += other.live_nodes;
+		bytes += other.bytes;
+		peak_bytes += other.peak_bytes;
+		allocations += other.allocations;
+		frees += other.frees;
+		for (int id = 0; id < (int)other.operations.size(); ++id) {
+			operation(id).calls += other.operations[id].calls;
+			operation(id).nodes_traversed += other.operations[id].nodes_traversed;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Clears the operation counters and the peak (live memory is kept)
+	 */
+	void reset_operations() {
+		operations.clear();
+		peak_bytes = bytes;
+	}
+
+	/**
+	 * @brief Exports all counters as a JSON object
+	 */
+	std::string to_json() const {
+		std::ostringstream oss;
+		oss << "{\"live_nodes\":" << live_nodes
+			<< ",\"bytes\":" << bytes
+			<< ",\"peak_bytes\":" << peak_bytes
+			<< ",\"allocations\":" << allocations
+			<< ",\"frees\":" << frees
+			<< ",\"operations\":{";
+
+		std::lock_guard<std::mutex> lock(registry_lock());
+		const std::vector<std::string>& names = operation_names();
+		bool first = true;
+		for (int id = 0; id < (int)operations.size(); ++id) {
+			if (!operations[id].calls)
+				continue;
+			if (!first)
+				oss << ",";
+			first = false;
+			oss << "\"" << names[id] << "\":{\"calls\":" << operations[id].calls
+				<< ",\"nodes_traversed\":" << operations[id].nodes_traversed << "}";
+		}
+		oss << "}}";
+		return oss.str();
+	}
+
+	/**
+	 * @brief Counts one call of an operation and the nodes it walks
+	 *
+	 * Steps are kept in a local counter and added once when the scope ends.
+	 */
+	class Scope {
+	private:
+		ContainerStats& stats;
+		int id;
+		long long steps = 0;
+	public:
+		Scope(ContainerStats& stats, int id) :stats(stats), id(id) {
+			++stats.operation(id).calls;
+		}
+		~Scope() {
+			// Looked up again: nested operations may have grown the vector
+			stats.operation(id).nodes_traversed += steps;
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+		void step() { ++steps; }
+	};
+};
+
+#define DS_STATS_MEMBER		mutable ContainerStats stats;
+#define DS_STATS_ACCESSOR	ContainerStats get_stats() const { return stats; }
+#define DS_STATS_ALLOC(size)	stats.on_alloc(size)
+#define DS_STATS_FREE(size)		stats.on_free(size)
+#define DS_STATS_MOVE_NODES(from, count, size)	stats.take_nodes((from).stats, count, size)
+#define DS_STATS_GIVE_NODES(to, count, size)	(to).stats.take_nodes(stats, count, size)
+#define DS_STATS_OP(name) \
+	static const int ds_stats_op_id = ContainerStats::register_operation(name); \
+	ContainerStats::Scope ds_stats_scope(stats, ds_stats_op_id)
+#define DS_STATS_STEP()		ds_stats_scope.step()
+
+#else
+
+#define DS_STATS_MEMBER
+#define DS_STATS_ACCESSOR
+#define DS_STATS_ALLOC(size)
+#define DS_STATS_FREE(size)
+#define DS_STATS_MOVE_NODES(from, count, size)
+#define DS_STATS_GIVE_NODES(to, count, size)
+#define DS_STATS_OP(name)
+#define DS_STATS_STEP()
+
+#endif
@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file Generator.h
+ * @brief C++20 coroutine generator and lazy pipeline stages for streaming traversal
+ *
+ * A Generator<T> produces its values one at a time: the coroutine runs
+ * until the next co_yield, hands out a reference to the value, and sleeps
+ * until the consumer asks for more. Nothing is buffered, so walking a list
+ * through a generator uses constant memory whatever its length.
+ *
+ * Pipeline stages combine generators lazily with operator|:
+ * @code
+ * for (const vector<int>& batch : list.values()
+ *         | pipeline::filter([](int x) { return x % 2 == 0; })
+ *         | pipeline::map([](int x) { return x * x; })
+ *         | pipeline::take(100)
+ *         | pipeline::chunk(10))
+ *     send(batch);
+ * @endcode
+ * Each stage pulls one value from the stage before it when its own consumer
+ * asks for one; take() stops the upstream walk as soon as it has enough.
+ *
+ * Everything here needs coroutine support (C++20). DS_HAS_COROUTINES is
+ * defined when it is available, and the containers declare their generator
+ * functions only then, so older language modes still build.
+ *
+ * A generator over a container reads the live nodes: do not insert or
+ * delete nodes while one is suspended in the middle of a traversal.
+ */
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define DS_HAS_COROUTINES
+#endif
+#endif
+
+#ifdef DS_HAS_COROUTINES
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lazy sequence of T produced by a coroutine (single pass, move-only)
+ */
+template <typename T>
+class Generator {
+public:
+	struct promise_type
+	{
+		const T* current{};			///< Value of the last co_yield (lives in the suspended frame)
+		std::exception_ptr error;	///< Exception thrown by the coroutine body
+
+		Generator get_return_object() {
+			return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		std::suspend_always yield_value(const T& value) noexcept {
+			current = std::addressof(value);
+			return {};
+		}
+		void return_void() {}
+		void unhandled_exception() { error = std::current_exception(); }
+	};
+
+	/**
+	 * @brief Input iterator; each increment resumes the coroutine once
+	 */
+	class iterator {
+	private:
+		std::coroutine_handle<promise_type> coroutine;
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		iterator() {}
+		explicit iterator(std::coroutine_handle<promise_type> coroutine) :coroutine(coroutine) {}
+
+		reference operator*() const { return *coroutine.promise().current; }
+		pointer operator->() const { return coroutine.promise().current; }
+
+		iterator& operator++() {
+			resume(coroutine);
+			return *this;
+		}
+		void operator++(int) { ++*this; }
+
+		friend bool operator==(const iterator& it, std::default_sentinel_t) {
+			return !it.coroutine || it.coroutine.done();
+		}
+	};
+
+	Generator(Generator&& other) noexcept :coroutine(std::exchange(other.coroutine, nullptr)) {}
+
+	Generator& operator=(Generator&& other) noexcept {
+		if (this != &other) {
+			if (coroutine)
+				coroutine.destroy();
+			coroutine = std::exchange(other.coroutine, nullptr);
+		}
+		return *this;
+	}
+
+	Generator(const Generator&) = delete;
+	Generator& operator=(const Generator&) = delete;
+
+	/**
+	 * @brief Destroys the coroutine frame, also when it stopped halfway
+	 */
+	~Generator() {
+		if (coroutine)
+			coroutine.destroy();
+	}
+
+	/**
+	 * @brief Runs the coroutine up to its first value (call once)
+	 */
+	iterator begin() {
+		if (coroutine)
+			resume(coroutine);
+		return iterator(coroutine);
+	}
+
+	std::default_sentinel_t end() { return {}; }
+
+private:
+	std::coroutine_handle<promise_type> coroutine;
+
+	explicit Generator(std::coroutine_handle<promise_type> coroutine) :coroutine(coroutine) {}
+
+	// Resumes and forwards an exception of the coroutine body to the consumer
+	static void resume(std::coroutine_handle<promise_type> coroutine) {
+		coroutine.resume();
+		if (coroutine.promise().error)
+			std::rethrow_exception(std::exchange(coroutine.promise().error, nullptr));
+	}
+};
+
+/**
+ * @brief Lazy stages to chain after a generator with operator|
+ */
+namespace pipeline {
+	template <typename Predicate>
+	struct FilterStage { Predicate pred; };
+
+	template <typename Function>
+	struct MapStage { Function f; };
+
+	struct TakeStage { int count; };
+
+	struct ChunkStage { int size; };
+
+	/**
+	 * @brief Keeps the values for which pred(value) is true
+	 */
+	template <typename Predicate>
+	FilterStage<Predicate> filter(Predicate pred) {
+		return { std::move(pred) };
+	}
+
+	/**
+	 * @brief Replaces every value by f(value)
+	 */
+	template <typename Function>
+	MapStage<Function> map(Function f) {
+		return { std::move(f) };
+	}
+
+	/**
+	 * @brief Stops after the first count values
+	 */
+	inline TakeStage take(int count) {
+		return { count };
+	}
+
+	/**
+	 * @brief Groups values into vectors of size values (the last one may be shorter)
+	 *
+	 * Memory is bounded by one chunk, not by the length of the input.
+	 */
+	inline ChunkStage chunk(int size) {
+		return { size };
+	}
+
+	// Stages take the source by value, so the coroutine frame owns it
+
+	template <typename T, typename Predicate>
+	Generator<T> operator|(Generator<T> source, FilterStage<Predicate> stage) {
+		for (const T& value : source)
+			if (stage.pred(value))
+				co_yield value;
+	}
+
+	template <typename T, typename Function>
+	Generator<std::decay_t<std::invoke_result_t<Function&, const T&>>> operator|(Generator<T> source, MapStage<Function> stage) {
+		for (const T& value : source)
+			co_yield stage.f(value);
+	}
+
+	template <typename T>
+	Generator<T> operator|(Generator<T> source, TakeStage stage) {
+		if (stage.count <= 0)
+			co_return;
+		int left = stage.count;
+		for (const T& value : source) {
+			co_yield value;
+			if (--left == 0)
+				co_return;	// the source frame is destroyed without finishing its walk
+		}
+	}
+
+	template <typename T>
+	Generator<std::vector<T>> operator|(Generator<T> source, ChunkStage stage) {
+		std::vector<T> batch;
+		batch.reserve(stage.size > 0 ? stage.size : 1);
+		for (const T& value : source) {
+			batch.push_back(value);
+			if ((int)batch.size() >= stage.size) {
+				co_yield batch;
+				batch.clear();
+			}
+		}
+		if (!batch.empty())
+			co_yield batch;
+	}
+}
+
+#endif
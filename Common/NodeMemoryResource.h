@@ -0,0 +1,227 @@
+#pragma once
+
+/**
+ * @file NodeMemoryResource.h
+ * @brief Slab allocator for node storage with optional huge pages and NUMA placement
+ *
+ * Containers keep their nodes in large contiguous slabs (see NodeArena.h,
+ * which every list and sparse structure allocates nodes from) and get the
+ * slab memory here. By
+ * default a slab is plain ::operator new memory. Two options reduce the cost
+ * of walking tens of millions of nodes:
+ *
+ * - Huge pages: a slab of at least one huge page (2 MB) is backed by huge
+ *   pages, so one TLB entry covers 2 MB of nodes instead of 4 KB.
+ *   HugePages::transparent asks the kernel for transparent huge pages
+ *   (MADV_HUGEPAGE); HugePages::explicit_pages uses the reserved hugetlbfs
+ *   pool (MAP_HUGETLB, or MEM_LARGE_PAGES on Windows) and falls back to
+ *   transparent pages when the pool is empty.
+ * - NUMA placement: the slab is bound to the memory node of the CPU the
+ *   allocating thread runs on, so the thread that builds and walks the
+ *   list reads local memory.
+ *
+ * Every step falls back silently: when a request cannot be honoured the
+ * slab is still allocated, just with normal pages or default placement.
+ * Slab records what it actually got.
+ */
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+/**
+ * @brief Huge page policy for slabs
+ */
+enum class HugePages
+{
+	none,			///< Normal pages
+	transparent,	///< Transparent huge pages where the kernel supports them
+	explicit_pages	///< Reserved huge pages, falling back to transparent ones
+};
+
+/**
+ * @brief Memory obtained from NodeMemoryResource, needed to give it back
+ */
+struct Slab
+{
+	void* memory{};				///< Start of the usable memory
+	std::size_t bytes{};		///< Bytes requested by the caller
+	std::size_t mapped_bytes{};	///< Bytes actually mapped (0 for ::operator new memory)
+	bool huge_pages = false;	///< Backed by explicit huge pages or advised for transparent ones
+	int numa_node = -1;			///< Memory node the slab is bound to (-1 if not bound)
+};
+
+class NodeMemoryResource {
+public:
+	/**
+	 * @brief Allocation policy shared by all slabs
+	 */
+	struct Options
+	{
+		HugePages huge_pages = HugePages::none;	///< Huge page policy
+		bool bind_to_local_node = false;		///< Bind slabs to the allocating thread's NUMA node
+	};
+
+	static const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+	/**
+	 * @brief Current policy (change it only while no slab is being allocated)
+	 */
+	static Options& options() {
+		static Options current;
+		return current;
+	}
+
+	/**
+	 * @brief Allocates a slab of at least bytes, aligned for any node type
+	 */
+	static Slab allocate(std::size_t bytes) {
+		Slab slab;
+		slab.bytes = bytes;
+		const Options& opts = options();
+
+		// Small slabs would waste most of a huge page; binding alone is still worth a mapping
+		bool want_huge = opts.huge_pages != HugePages::none && bytes >= huge_page_size;
+		if ((want_huge || opts.bind_to_local_node) && map_pages(slab, want_huge, opts))
+			return slab;
+
+		slab.memory = ::operator new(bytes);
+		return slab;
+	}
+
+	/**
+	 * @brief Returns a slab obtained from allocate()
+	 */
+	static void deallocate(const Slab& slab) {
+		if (!slab.memory)
+			return;
+		if (!slab.mapped_bytes) {
+			::operator delete(slab.memory);
+			return;
+		}
+#if defined(__linux__)
+		munmap(slab.memory, slab.mapped_bytes);
+#elif defined(_WIN32)
+		VirtualFree(slab.memory, 0, MEM_RELEASE);
+#endif
+	}
+
+	/**
+	 * @brief NUMA node of the CPU the calling thread runs on (-1 if unknown)
+	 */
+	static int current_numa_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+		unsigned cpu = 0, node = 0;
+		if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+			return (int)node;
+#elif defined(_WIN32)
+		PROCESSOR_NUMBER processor;
+		GetCurrentProcessorNumberEx(&processor);
+		USHORT node = 0;
+		if (GetNumaProcessorNodeEx(&processor, &node))
+			return (int)node;
+#endif
+		return -1;
+	}
+
+private:
+	static std::size_t round_up(std::size_t bytes, std::size_t unit) {
+		return (bytes + unit - 1) / unit * unit;
+	}
+
+	/**
+	 * @brief Maps pages for a slab; false if the platform gave nothing usable
+	 */
+	static bool map_pages(Slab& slab, bool want_huge, const Options& opts) {
+#if defined(__linux__)
+		int node = opts.bind_to_local_node ? current_numa_node() : -1;
+
+		void* memory = MAP_FAILED;
+		std::size_t length = 0;
+#ifdef MAP_HUGETLB
+		if (want_huge && opts.huge_pages == HugePages::explicit_pages) {
+			length = round_up(slab.bytes, huge_page_size);
+			memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (memory != MAP_FAILED)
+				slab.huge_pages = true;
+		}
+#endif
+		if (memory == MAP_FAILED && want_huge) {
+			// Over-map by one huge page and trim, so the slab starts on a 2 MB boundary
+			length = round_up(slab.bytes, huge_page_size);
+			char* raw = (char*)mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw != MAP_FAILED) {
+				char* aligned = (char*)round_up((std::size_t)raw, huge_page_size);
+				if (aligned != raw)
+					munmap(raw, aligned - raw);
+				if (aligned + length != raw + length + huge_page_size)
+					munmap(aligned + length, raw + huge_page_size - aligned);
+				memory = aligned;
+#ifdef MADV_HUGEPAGE
+				slab.huge_pages = madvise(memory, length, MADV_HUGEPAGE) == 0;
+#endif
+			}
+		}
+		if (memory == MAP_FAILED) {
+			length = round_up(slab.bytes, (std::size_t)sysconf(_SC_PAGESIZE));
+			memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		}
+		if (memory == MAP_FAILED)
+			return false;
+
+		// Bind before the first touch, so pages are faulted in on the right node
+#ifdef SYS_mbind
+		if (node >= 0 && node < (int)(8 * sizeof(unsigned long))) {
+			const int mpol_preferred = 1;	// MPOL_PREFERRED: fall back to other nodes when full
+			unsigned long mask = 1UL << node;
+			if (syscall(SYS_mbind, memory, length, mpol_preferred, &mask, 8 * sizeof(mask), 0) == 0)
+				slab.numa_node = node;
+		}
+#endif
+		slab.memory = memory;
+		slab.mapped_bytes = length;
+		return true;
+#elif defined(_WIN32)
+		int node = opts.bind_to_local_node ? current_numa_node() : -1;
+		DWORD preferred = node >= 0 ? (DWORD)node : NUMA_NO_PREFERRED_NODE;
+
+		void* memory = nullptr;
+		std::size_t length = 0;
+		// Large pages need the "Lock pages in memory" privilege; without it the call fails
+		std::size_t large_page = GetLargePageMinimum();
+		if (want_huge && opts.huge_pages == HugePages::explicit_pages && large_page) {
+			length = round_up(slab.bytes, large_page);
+			memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, length,
+				MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, preferred);
+			slab.huge_pages = memory != nullptr;
+		}
+		if (!memory) {
+			length = round_up(slab.bytes, 64 * 1024);
+			memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, length,
+				MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, preferred);
+		}
+		if (!memory)
+			return false;
+
+		slab.memory = memory;
+		slab.mapped_bytes = length;
+		slab.numa_node = node;
+		return true;
+#else
+		(void)slab;
+		(void)want_huge;
+		(void)opts;
+		return false;
+#endif
+	}
+};
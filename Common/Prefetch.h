@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * @file Prefetch.h
+ * @brief Portable software prefetch hint for pointer-chasing loops
+ *
+ * DS_PREFETCH(address) asks the CPU to start loading the cache line of a
+ * node that the loop will visit soon, so the load overlaps with the work on
+ * the current node. It is only a hint: it never faults, so nullptr or an
+ * address past the end of a list is fine, and it expands to nothing on
+ * compilers without a prefetch intrinsic.
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DS_PREFETCH(address)	__builtin_prefetch(static_cast<const void*>(address), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define DS_PREFETCH(address)	_mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define DS_PREFETCH(address)	((void)(address))
+#endif
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Thread-safe double-ended queue with one lock per end
+ *
+ * The deque keeps the LinkedList layout (nodes linked with next/prev between
+ * a head and a tail) but puts a sentinel node at each end, so a push or pop
+ * only touches its own end of the chain. Each end has its own mutex:
+ * producers on one end and consumers on the other never take the same lock.
+ *
+ * While the deque holds only a few nodes, the two ends can reach the same
+ * nodes. Below fast_path_min_size elements an operation takes both locks,
+ * always head first, which keeps the short-queue case correct and
+ * deadlock-free.
+ *
+ * Features:
+ * - push_front / push_back / try_pop_front / try_pop_back from any thread
+ * - Blocking pop_front / pop_back that sleep until an element arrives
+ * - close() wakes every blocked consumer for shutdown
+ *
+ * Example:
+ * @code
+ * ConcurrentDeque<int> work;
+ * std::thread producer([&] { for (int i = 0; i < 100; ++i) work.push_back(i); work.close(); });
+ * int task;
+ * while (work.pop_front(task))
+ *     process(task);
+ * producer.join();
+ * @endcode
+ */
+template <typename T>
+class ConcurrentDeque {
+private:
+	struct Link
+	{
+		Link* next{};
+		Link* prev{};
+	};
+
+	struct Node : Link
+	{
+		T data;
+		Node(T&& data) :data(std::move(data)) {}
+	};
+
+	/**
+	 * @brief One end of the deque; kept on its own cache line
+	 */
+	struct alignas(64) End
+	{
+		std::mutex lock;
+		Link sentinel;
+	};
+
+	/// Below this many elements the two ends may touch the same nodes
+	static const int fast_path_min_size = 4;
+
+	End front_end;					///< front_end.sentinel.next is the first node
+	End back_end;					///< back_end.sentinel.prev is the last node
+	std::atomic<int> length{ 0 };	///< Number of elements
+
+	// Blocking pops
+	std::mutex wait_lock;
+	std::condition_variable not_empty;
+	std::atomic<int> sleepers{ 0 };		///< Consumers inside a blocking pop
+	std::atomic<bool> closed{ false };
+
+	static void link(Link* first, Link* second) {
+		first->next = second;
+		second->prev = first;
+	}
+
+	/**
+	 * @brief Locks the requested end, or both ends while the deque is short
+	 * @param front True for the head end, false for the tail end
+	 * @param own Receives the lock of the requested end (or the head lock)
+	 * @param other Receives the tail lock when both ends are needed
+	 */
+	void lock_end(bool front, std::unique_lock<std::mutex>& own, std::unique_lock<std::mutex>& other) {
+		own = std::unique_lock<std::mutex>(front ? front_end.lock : back_end.lock);
+		if (length.load() >= fast_path_min_size)
+			return;
+		// Short deque: the ends may meet, so hold both (head then tail)
+		own.unlock();
+		own = std::unique_lock<std::mutex>(front_end.lock);
+		other = std::unique_lock<std::mutex>(back_end.lock);
+	}
+
+	void push(T&& value, bool front) {
+		Node* item = new Node(std::move(value));
+		{
+			std::unique_lock<std::mutex> own, other;
+			lock_end(front, own, other);
+			if (front) {
+				link(item, front_end.sentinel.next);
+				link(&front_end.sentinel, item);
+			}
+			else {
+				link(back_end.sentinel.prev, item);
+				link(item, &back_end.sentinel);
+			}
+			length.fetch_add(1);
+		}
+		wake_one();
+	}
+
+	bool try_pop(T& out, bool front) {
+		Node* item;
+		{
+			std::unique_lock<std::mutex> own, other;
+			lock_end(front, own, other);
+			// Each end only reads its own sentinel
+			Link* first = front ? front_end.sentinel.next : back_end.sentinel.prev;
+			if (first == &back_end.sentinel || first == &front_end.sentinel)
+				return false;
+			item = static_cast<Node*>(first);
+			if (front)
+				link(&front_end.sentinel, item->next);
+			else
+				link(item->prev, &back_end.sentinel);
+			length.fetch_sub(1);
+		}
+		out = std::move(item->data);
+		delete item;
+		return true;
+	}
+
+	bool wait_and_pop(T& out, bool front) {
+		if (try_pop(out, front))
+			return true;
+
+		// Announce ourselves before the last check so a push cannot slip by unnoticed
+		sleepers.fetch_add(1);
+		std::unique_lock<std::mutex> lock(wait_lock);
+		bool popped;
+		while (!(popped = try_pop(out, front)) && !closed.load())
+			not_empty.wait(lock);
+		sleepers.fetch_sub(1);
+		return popped;
+	}
+
+	void wake_one() {
+		// Producers only pay for the wait lock when someone is asleep
+		if (sleepers.load() == 0)
+			return;
+		std::lock_guard<std::mutex> lock(wait_lock);
+		not_empty.notify_one();
+	}
+
+public:
+	ConcurrentDeque() {
+		link(&front_end.sentinel, &back_end.sentinel);
+	}
+
+	/**
+	 * @brief Deletes the remaining elements (no other thread may use the deque)
+	 */
+	~ConcurrentDeque() {
+		Link* cur = front_end.sentinel.next;
+		while (cur != &back_end.sentinel) {
+			Link* next = cur->next;
+			delete static_cast<Node*>(cur);
+			cur = next;
+		}
+	}
+
+	ConcurrentDeque(const ConcurrentDeque&) = delete;
+	ConcurrentDeque& operator=(const ConcurrentDeque&) = delete;
+
+	/**
+	 * @brief Inserts a value at the front
+	 */
+	void push_front(T value) {
+		push(std::move(value), true);
+	}
+
+	/**
+	 * @brief Inserts a value at the back
+	 */
+	void push_back(T value) {
+		push(std::move(value), false);
+	}
+
+	/**
+	 * @brief Removes the front value without blocking
+	 * @param out Receives the value
+	 * @return False if the deque was empty
+	 */
+	bool try_pop_front(T& out) {
+		return try_pop(out, true);
+	}
+
+	/**
+	 * @brief Removes the back value without blocking
+	 * @param out Receives the value
+	 * @return False if the deque was empty
+	 */
+	bool try_pop_back(T& out) {
+		return try_pop(out, false);
+	}
+
+	/**
+	 * @brief Removes the front value, waiting for one if the deque is empty
+	 * @param out Receives the value
+	 * @return False only if the deque was closed and is empty
+	 */
+	bool pop_front(T& out) {
+		return wait_and_pop(out, true);
+	}
+
+	/**
+	 * @brief Removes the back value, waiting for one if the deque is empty
+	 * @param out Receives the value
+	 * @return False only if the deque was closed and is empty
+	 */
+	bool pop_back(T& out) {
+		return wait_and_pop(out, false);
+	}
+
+	/**
+	 * @brief Wakes every blocked consumer; blocking pops then fail once the deque is empty
+	 *
+	 * Pushing after close() is still allowed and the values can still be popped.
+	 */
+	void close() {
+		std::lock_guard<std::mutex> lock(wait_lock);
+		closed.store(true);
+		not_empty.notify_all();
+	}
+
+	/**
+	 * @brief Number of elements (a snapshot while other threads are active)
+	 */
+	int size() const {
+		return length.load();
+	}
+
+	bool is_empty() const {
+		return size() == 0;
+	}
+};
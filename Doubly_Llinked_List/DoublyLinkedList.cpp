@@ -1,7 +1,12 @@
 #include "DoublyLinkedList.h"
+#include "../Common/Prefetch.h"
 #include <cassert>
+#include <algorithm>
 #include <vector>
 #include <sstream>
+#include <unordered_map>
+#include <new>
+#include <thread>
 //#define ll long long
 #define el '\n'
 
@@ -13,13 +18,19 @@ using std::cout;
 
 LinkedList::LinkedList() {}
 
+LinkedList::LinkedList(NodeSlot* inline_slots, int inline_capacity)
+	:inline_slots(inline_slots), inline_capacity(inline_capacity) {
+	assert(0 < inline_capacity && inline_capacity <= 64);
+	inline_free = inline_capacity == 64 ? ~0ULL : (1ULL << inline_capacity) - 1;
+}
+
 // Destructor implementation provided by ChatGPT
 LinkedList::~LinkedList() {
 	Node* cur = head;
 	// Traverse the list and delete each node
 	while (cur) {
 		Node* next = cur->next;
-		delete cur;
+		release_node(cur);
 		cur = next;
 	}
 	// Reset all member variables to clean state
@@ -33,16 +44,34 @@ LinkedList::~LinkedList() {
 //====================================================================================
 
 void LinkedList::debug_add_node(Node* node) {
-	// Add node pointer to debug tracking vector
+	// Add node pointer to debug tracking vector, remembering where it went
+	node->debug_index = (int)debug_data.size();
 	debug_data.push_back(node);
 }
 
 void LinkedList::debug_remove_node(Node* node) {
-	// Find and remove node pointer from debug tracking vector
-	auto it = find(debug_data.begin(), debug_data.end(), node);
-	if (it == debug_data.end())
+	// Swap with the last record and pop: no search, no shifting
+	int index = node->debug_index;
+	if (index < 0 || index >= (int)debug_data.size() || debug_data[index] != node) {
 		cout << "Node does not exist\n";
-	else debug_data.erase(it);
+		return;
+	}
+	Node* last = debug_data.back();
+	debug_data[index] = last;
+	last->debug_index = index;
+	debug_data.pop_back();
+	node->debug_index = -1;
+}
+
+void LinkedList::debug_take_nodes(LinkedList& other) {
+	for (Node* node : other.debug_data)
+		debug_add_node(node);
+	other.debug_data.clear();
+}
+
+void LinkedList::reset_finger() {
+	finger = nullptr;
+	finger_pos = 0;
 }
 
 void LinkedList::debuge_print_address() {
@@ -108,6 +137,7 @@ string LinkedList::debug_to_string() {
 }
 
 void LinkedList::debug_verfiy_data_integrity() {
+#ifndef NDEBUG
 	// Comprehensive integrity check of the list structure
 	if (length == 0) {
 		// Empty list checks
@@ -143,6 +173,26 @@ void LinkedList::debug_verfiy_data_integrity() {
 		if (len == length - 1)	// make sure we end at head
 			assert(cur == head);
 	}
+#endif
+}
+
+void LinkedList::debug_verify_around(Node* node) {
+#ifdef NDEBUG
+	(void)node;
+#else
+	// Ends and counters, as in the full check but without the walks
+	assert((length == 0) == (head == nullptr));
+	assert((length == 0) == (tail == nullptr));
+	assert(!head || !head->prev);
+	assert(!tail || !tail->next);
+	assert(length == (int)debug_data.size());
+
+	if (!node)
+		return;
+	assert(debug_data[node->debug_index] == node);
+	assert(node->prev ? node->prev->next == node : node == head);
+	assert(node->next ? node->next->prev == node : node == tail);
+#endif
 }
 
 //====================================================================================
@@ -154,13 +204,103 @@ void LinkedList::delete_node(Node* node) {
 	// Remove from debug tracking and decrement length before deletion
 	debug_remove_node(node);
 	--length;
-	delete node;
+	reset_finger();
+	release_node(node);
+}
+
+Node* LinkedList::create_node(int val) {
+	DS_STATS_ALLOC(sizeof(Node));
+	if (inline_free) {
+		// Lowest free slot first, so short lists stay packed at the front
+		int slot = 0;
+		while (!(inline_free >> slot & 1))
+			++slot;
+		inline_free &= ~(1ULL << slot);
+		return new (inline_slots[slot].storage) Node(val);
+	}
+	return arena.create(val);
+}
+
+void LinkedList::release_node(Node* node) {
+	DS_STATS_FREE(sizeof(Node));
+	if (is_inline(node)) {
+		node->~Node();
+		retire_handle(node);
+		inline_free |= 1ULL << inline_index(node);
+	}
+	else
+		arena.destroy(node);	// moves the slot to a new generation
+}
+
+bool LinkedList::is_inline(Node* node) const {
+	const NodeSlot* slot = reinterpret_cast<const NodeSlot*>(node);
+	return inline_slots <= slot && slot < inline_slots + inline_capacity;
+}
+
+int LinkedList::inline_index(Node* node) const {
+	return int(reinterpret_cast<const NodeSlot*>(node) - inline_slots);
+}
+
+Node* LinkedList::spill_inline_nodes(Node* first) {
+	unsigned long long full = inline_capacity == 64 ? ~0ULL : (1ULL << inline_capacity) - 1;
+	if (inline_free == full)
+		return first;
+
+	for (Node* cur = first; cur; cur = cur->next) {
+		if (!is_inline(cur))
+			continue;
+		Node* moved = arena.create(cur->data);
+		if (cur == head)
+			head = moved;
+		if (cur == tail)
+			tail = moved;
+		link(cur->prev, moved);
+		link(moved, cur->next);
+		moved->debug_index = cur->debug_index;
+		debug_data[moved->debug_index] = moved;
+
+		// Relocation: the slot is reused without running ~Node()
+		retire_handle(cur);
+		inline_free |= 1ULL << inline_index(cur);
+		if (cur == first)
+			first = moved;
+		cur = moved;
+	}
+	reset_finger();
+	return first;
+}
+
+void LinkedList::release_batch(vector<Node*>& removed) {
+	// One bookkeeping pass for the whole batch
+	length -= (int)removed.size();
+	for (Node* node : removed)
+		debug_remove_node(node);
+	reset_finger();
+
+	for (Node* node : removed)
+		release_node(node);
+
+	debug_verfiy_data_integrity();
+}
+
+void LinkedList::retire_handle(Node* node) {
+	NodeArena<Node, true>::retire(node);	// outstanding handles become stale
+}
+
+void LinkedList::retire_all_handles() {
+	++handle_epoch;
+}
+
+void LinkedList::take_arena(LinkedList& other) {
+	arena.adopt(other.arena);
+	other.arena.reset();
 }
 
 void LinkedList::add_node(Node* node) {
 	// Add to debug tracking and increment length
 	debug_add_node(node);
 	++length;
+	reset_finger();
 }
 
 //====================================================================================
@@ -194,9 +334,10 @@ void LinkedList::link(Node* first, Node* second)
 		second->prev = first;
 }
 
-void LinkedList::insert_end(int val) {
+NodeHandle LinkedList::insert_end(int val) {
+	DS_STATS_OP("insert_end");
 	// Create new node and add to end of list
-	Node* item = new Node(val);
+	Node* item = create_node(val);
 	add_node(item);
 
 	if (!head)
@@ -208,12 +349,14 @@ void LinkedList::insert_end(int val) {
 		tail = item;
 	}
 
-	debug_verfiy_data_integrity();
+	debug_verify_around(item);
+	return handle_of(item);
 }
 
-void LinkedList::insert_front(int val) {
+NodeHandle LinkedList::insert_front(int val) {
+	DS_STATS_OP("insert_front");
 	// Create new node and add to beginning of list
-	Node* item = new Node(val);
+	Node* item = create_node(val);
 	add_node(item);
 
 	if (!head)
@@ -224,38 +367,139 @@ void LinkedList::insert_front(int val) {
 		link(item, head);
 		head = item;
 	}
-	debug_verfiy_data_integrity();
+	debug_verify_around(item);
+	return handle_of(item);
 }
 
-void LinkedList::embed_after(Node* node_before, int val) {
+Node* LinkedList::embed_after(Node* node_before, int val) {
 	// Insert new node between node_before and its current next node
-	Node* item = new Node(val);
+	Node* item = create_node(val);
 	add_node(item);
 
 	Node* node_after = node_before->next;
 	link(node_before, item);
 	link(item, node_after);
+	return item;
 }
 
-void LinkedList::insert_sorted(int val) {
+NodeHandle LinkedList::insert_sorted(int val) {
+	DS_STATS_OP("insert_sorted");
 	// Insert value in correct position to maintain sorted order
 	if (!length || head->data >= val)
 		// Empty list or value should be first
-		insert_front(val);
-	else if (tail->data <= val)
+		return insert_front(val);
+	if (tail->data <= val)
 		// Value should be last
-		insert_end(val);
-	else {
-		// Find correct position and insert
-		for (auto cur = head; cur; cur = cur->next) {
-			if (val <= cur->data) {
-				embed_after(cur->prev, val);
-				break;
-			}
+		return insert_end(val);
+
+	// Find correct position and insert
+	Node* item{};
+	for (auto cur = head; cur; cur = cur->next) {
+		DS_STATS_STEP();
+		if (val <= cur->data) {
+			item = embed_after(cur->prev, val);
+			break;
 		}
 	}
 
 	debug_verfiy_data_integrity();
+	return handle_of(item);
+}
+
+NodeHandle LinkedList::insert_at(int n, int val)
+{
+	DS_STATS_OP("insert_at");
+	// Insert so the new node ends up at position n
+	if (n <= 0 || n > length + 1)
+		return NodeHandle();
+	if (n == 1)
+		return insert_front(val);
+	if (n == length + 1)
+		return insert_end(val);
+
+	Node* item = embed_after(get_nth_node(n - 1), val);
+	debug_verfiy_data_integrity();
+	return handle_of(item);
+}
+
+NodeHandle LinkedList::insert_before(NodeHandle pos, int val)
+{
+	DS_STATS_OP("insert_before");
+	Node* node = resolve(pos);
+	if (!node)
+		return NodeHandle();
+	if (node == head)
+		return insert_front(val);
+
+	Node* item = embed_after(node->prev, val);
+	debug_verify_around(item);
+	return handle_of(item);
+}
+
+NodeHandle LinkedList::insert_after(NodeHandle pos, int val)
+{
+	DS_STATS_OP("insert_after");
+	Node* node = resolve(pos);
+	if (!node)
+		return NodeHandle();
+	if (node == tail)
+		return insert_end(val);
+
+	Node* item = embed_after(node, val);
+	debug_verify_around(item);
+	return handle_of(item);
+}
+
+//====================================================================================
+// HANDLE FUNCTIONS
+//====================================================================================
+
+NodeHandle LinkedList::handle_of(Node* node)
+{
+	// The generation lives in the node's slot: nothing to allocate
+	NodeHandle handle;
+	handle.node = node;
+	handle.generation = NodeArena<Node, true>::generation(node);
+	handle.epoch = handle_epoch;
+	return handle;
+}
+
+bool LinkedList::is_valid(NodeHandle handle) const
+{
+	return resolve(handle) != nullptr;
+}
+
+Node* LinkedList::resolve(NodeHandle handle) const
+{
+	// Check the epoch first: the slot of an older epoch may be freed memory
+	if (!handle.node || handle.epoch != handle_epoch)
+		return nullptr;
+	if (NodeArena<Node, true>::generation(handle.node) != handle.generation)
+		return nullptr;	// the node was deleted or moved away
+	return handle.node;
+}
+
+bool LinkedList::erase(NodeHandle handle)
+{
+	DS_STATS_OP("erase");
+	Node* node = resolve(handle);
+	if (!node)
+		return false;
+
+	Node* before = node->prev;
+	if (node == head)
+		head = node->next;
+	if (node == tail)
+		tail = node->prev;
+	link(node->prev, node->next);
+	if (head)
+		head->prev = nullptr;
+	if (tail)
+		tail->next = nullptr;
+	delete_node(node);
+
+	debug_verify_around(before ? before : head);
+	return true;
 }
 
 //====================================================================================
@@ -273,6 +517,7 @@ Node* LinkedList::delete_and_link(Node* cur)
 }
 
 void LinkedList::delete_front() {
+	DS_STATS_OP("delete_front");
 	// Delete the first node in the list
 	if (length == 0)
 		return;
@@ -287,11 +532,12 @@ void LinkedList::delete_front() {
 		// List became empty
 		tail = nullptr;
 
-	debug_verfiy_data_integrity();
+	debug_verify_around(head);
 }
 
 void LinkedList::delete_end()
 {
+	DS_STATS_OP("delete_end");
 	// Delete the last node in the list
 	if (length <= 1)
 		// Single node or empty list: use delete_front
@@ -303,10 +549,11 @@ void LinkedList::delete_end()
 		tail->next = nullptr;
 		delete_node(temp);
 	}
-	debug_verfiy_data_integrity();
+	debug_verify_around(tail);
 }
 
 void LinkedList::delete_node_with_key(int val) {
+	DS_STATS_OP("delete_node_with_key");
 	// Delete first occurrence of value
 	if (!length)
 		return;
@@ -316,6 +563,7 @@ void LinkedList::delete_node_with_key(int val) {
 		// Search for value and delete when found
 		for (Node* cur = head; cur; cur = cur->next)
 		{
+			DS_STATS_STEP();
 			if (cur->data == val) {
 				cur = delete_and_link(cur);
 				if (!cur->next) // tail
@@ -329,40 +577,22 @@ void LinkedList::delete_node_with_key(int val) {
 
 void LinkedList::delete_all_nodes_with_key(int val)
 {
-	// Delete all occurrences of the specified value
-	for (Node* cur = head; cur; )
-	{
-		if (cur->data == val) {
-			if (!cur->prev) {
-				// Deleting head node
-				delete_front();
-				cur = head;
-			}
-			else {
-				// Deleting non-head node
-				cur = delete_and_link(cur);
-				if (!cur->next) {
-					tail = cur;
-					break;
-				}
-			}
-		}
-		else {
-			cur = cur->next;
-		}
-	}
-
+	DS_STATS_OP("delete_all_nodes_with_key");
+	// Delete all occurrences of the specified value in one pass
+	erase_if([val](int data) { return data == val; });
 	debug_verfiy_data_integrity();
 }
 
 void LinkedList::delete_even_positions1()
 {
+	DS_STATS_OP("delete_even_positions1");
 	// Delete nodes at even positions (2nd, 4th, 6th, etc.) - Version 1
 	if (!length)
 		return;
 	int i = 1;
 	for (Node* cur = head; cur; ++i, cur = cur->next)
 	{
+		DS_STATS_STEP();
 		if (i % 2 == 0) {
 			// Even position: delete this node
 			cur = delete_and_link(cur);
@@ -383,11 +613,13 @@ void LinkedList::delete_even_positions1()
 
 void LinkedList::delete_even_positions2()
 {
+	DS_STATS_OP("delete_even_positions2");
 	// Delete nodes at even positions (2nd, 4th, 6th, etc.) - Version 2
 	if (length <= 1)
 		return;
 	// Iterate through odd positions and delete the next (even) node
 	for (Node* cur = head; cur && cur->next; cur = cur->next) {
+		DS_STATS_STEP();
 		delete_and_link(cur->next);
 		if (!cur->next) // even lenght
 			tail = cur;
@@ -397,6 +629,7 @@ void LinkedList::delete_even_positions2()
 
 void LinkedList::delete_odd_positions1()
 {
+	DS_STATS_OP("delete_odd_positions1");
 	// Delete nodes at odd positions (1st, 3rd, 5th, etc.) - Version 1
 	if (!length)
 		return;
@@ -407,6 +640,7 @@ void LinkedList::delete_odd_positions1()
 
 void LinkedList::delete_odd_positions2()
 {
+	DS_STATS_OP("delete_odd_positions2");
 	// Delete nodes at odd positions (1st, 3rd, 5th, etc.) - Version 2
 	if (!length)
 		return;
@@ -415,12 +649,30 @@ void LinkedList::delete_odd_positions2()
 	delete_even_positions2();
 }
 
+void LinkedList::delete_nth_node(int n)
+{
+	DS_STATS_OP("delete_nth_node");
+	// Delete node at position n (1-indexed)
+	if (n <= 0 || n > length)
+		return;
+	if (n == 1)
+		delete_front();
+	else if (n == length)
+		delete_end();
+	else {
+		// Middle node: both neighbours exist, head and tail stay the same
+		delete_and_link(get_nth_node(n));
+		debug_verfiy_data_integrity();
+	}
+}
+
 //====================================================================================
 // ANALYSIS FUNCTIONS
 //====================================================================================
 
 bool LinkedList::is_palindrome()
 {
+	DS_STATS_OP("is_palindrome");
 	// Check if list reads same forwards and backwards
 	if (!length)
 		return false;
@@ -430,6 +682,7 @@ bool LinkedList::is_palindrome()
 	Node* h = head, * t = tail;
 	while (len--)
 	{
+		DS_STATS_STEP();
 		if (abs(h->data) != abs(t->data))
 			return false;
 		h = h->next;
@@ -440,12 +693,14 @@ bool LinkedList::is_palindrome()
 
 int LinkedList::find_the_middle1()
 {
+	DS_STATS_OP("find_the_middle1");
 	// Find middle using two pointers moving from both ends
 	assert(head);
 
 	Node* h = head, * t = tail;
 	// Move pointers toward each other until they meet or cross
 	while (t != h && t->prev != h) {
+		DS_STATS_STEP();
 		h = h->next;
 		t = t->prev;
 	}
@@ -454,12 +709,14 @@ int LinkedList::find_the_middle1()
 
 int LinkedList::find_the_middle2()
 {
+	DS_STATS_OP("find_the_middle2");
 	// Find middle using tortoise and hare algorithm
 	assert(head);
 	Node* slow = head, * fast = head;
 	// Fast moves 2 steps, slow moves 1 step
 	// When fast reaches end, slow is at middle
 	while (fast && fast->next) {
+		DS_STATS_STEP();
 		slow = slow->next;
 		fast = fast->next->next;
 	}
@@ -470,24 +727,137 @@ int LinkedList::find_the_middle2()
 // ACCESS FUNCTIONS
 //====================================================================================
 
+int LinkedList::get_length() const
+{
+	return length;
+}
+
 Node* LinkedList::get_nth_node(int n)
 {
+	DS_STATS_OP("get_nth_node");
 	// Get nth node from beginning (1-indexed)
-	if (n > length)
+	if (n <= 0 || n > length)
 		return nullptr;
+
+	// Start from the closest of head, tail and the cached finger
 	Node* ret = head;
-	while (--n) ret = ret->next;
+	int pos = 1;
+	if (length - n < n - 1) {
+		ret = tail;
+		pos = length;
+	}
+	if (finger && abs(finger_pos - n) < abs(pos - n)) {
+		ret = finger;
+		pos = finger_pos;
+	}
+
+	for (; pos < n; ++pos) {
+		DS_STATS_STEP();
+		ret = ret->next;
+	}
+	for (; pos > n; --pos) {
+		DS_STATS_STEP();
+		ret = ret->prev;
+	}
+
+	finger = ret;
+	finger_pos = n;
 	return ret;
 }
 
 Node* LinkedList::get_nth_node_back(int n)
 {
 	// Get nth node from end (1-indexed)
-	if (n > length)
+	if (n <= 0 || n > length)
 		return nullptr;
-	Node* ret = tail;
-	while (--n) ret = ret->prev;
-	return ret;
+	return get_nth_node(length - n + 1);
+}
+
+vector<int> LinkedList::search_batch(const vector<int>& vals)
+{
+	DS_STATS_OP("search_batch");
+	vector<int> positions(vals.size(), -1);
+
+	// value -> indices in vals still waiting for it
+	std::unordered_map<int, vector<int>> pending;
+	for (int k = 0; k < (int)vals.size(); ++k)
+		pending[vals[k]].push_back(k);
+	// value -> smallest position the backward cursor has seen it at
+	std::unordered_map<int, int> seen_from_back;
+
+	Node* front = head;
+	Node* back = tail;
+	int i = 1, j = length;
+	for (; i <= j && !pending.empty(); front = front->next, back = back->prev, ++i, --j) {
+		DS_STATS_STEP();
+		auto it = pending.find(front->data);
+		if (it != pending.end()) {
+			for (int k : it->second)
+				positions[k] = i;
+			pending.erase(it);
+		}
+		if (i < j) {
+			DS_STATS_STEP();
+			if (pending.count(back->data))
+				seen_from_back[back->data] = j;
+		}
+	}
+
+	// Values missing from the first half: their first occurrence is the
+	// leftmost one the backward cursor saw
+	if (i > j) {
+		for (auto& p : pending) {
+			auto it = seen_from_back.find(p.first);
+			if (it != seen_from_back.end())
+				for (int k : p.second)
+					positions[k] = it->second;
+		}
+	}
+	return positions;
+}
+
+vector<Node*> LinkedList::get_nth_batch(const vector<int>& positions)
+{
+	DS_STATS_OP("get_nth_batch");
+	vector<Node*> nodes(positions.size(), nullptr);
+
+	vector<int> order(positions.size());
+	for (int k = 0; k < (int)order.size(); ++k)
+		order[k] = k;
+	std::sort(order.begin(), order.end(),
+		[&](int a, int b) { return positions[a] < positions[b]; });
+
+	// order[f..mid) is served from head, order[mid..b] from tail; the rest is out of range
+	int f = 0, b = (int)order.size() - 1;
+	while (f <= b && positions[order[f]] <= 0)
+		++f;
+	while (f <= b && positions[order[b]] > length)
+		--b;
+	int half = (length + 1) / 2;
+	int mid = f;
+	while (mid <= b && positions[order[mid]] <= half)
+		++mid;
+
+	Node* front = head;
+	Node* back = tail;
+	int i = 1, j = length;
+	while (f < mid || b >= mid) {
+		if (f < mid) {
+			DS_STATS_STEP();
+			while (f < mid && positions[order[f]] == i)
+				nodes[order[f++]] = front;
+			front = front->next;
+			++i;
+		}
+		if (b >= mid) {
+			DS_STATS_STEP();
+			while (b >= mid && positions[order[b]] == j)
+				nodes[order[b--]] = back;
+			back = back->prev;
+			--j;
+		}
+	}
+	return nodes;
 }
 
 //====================================================================================
@@ -496,9 +866,10 @@ Node* LinkedList::get_nth_node_back(int n)
 
 void LinkedList::swap_forward_with_backword(int k)
 {
+	DS_STATS_OP("swap_forward_with_backword");
 	// Swap kth node from start with kth node from end
 	int kth_back = length - k + 1;
-	if (k > length || k == kth_back)
+	if (k <= 0 || k > length || k == kth_back)
 		return;
 
 	// Ensure k is the smaller position for consistent handling
@@ -532,12 +903,19 @@ void LinkedList::swap_forward_with_backword(int k)
 	if (k == 1)
 		// Swapping head and tail
 		std::swap(head, tail);
+	reset_finger();
 	debug_verfiy_data_integrity();
 }
 
 void LinkedList::swap_kth(int k)
 {
+	DS_STATS_OP("swap_kth");
 	// Swap kth node from start with kth node from end
+	if (k <= 0 || k > length)
+		return;
+	// kth from the end is the same pair as (length - k + 1)th from the start
+	k = std::min(k, length - k + 1);
+
 	auto first = get_nth_node(k);
 	auto last = get_nth_node_back(k);
 	if (first == last)
@@ -571,11 +949,13 @@ void LinkedList::swap_kth(int k)
 	if (k == 1)
 		// Swapping involves head/tail
 		std::swap(head, tail);
+	reset_finger();
 	debug_verfiy_data_integrity();
 }
 
 void LinkedList::reverse()
 {
+	DS_STATS_OP("reverse");
 	// Reverse the entire list by changing link directions
 	if (length <= 1)
 		return;
@@ -583,6 +963,7 @@ void LinkedList::reverse()
 	// Reverse all the links by traversing and swapping directions
 	Node* first = head, * second = head->next;
 	while (second) {
+		DS_STATS_STEP();
 		Node* f = second, * s = second->next;
 		// Reverse the link direction
 		link(second, first);
@@ -594,15 +975,18 @@ void LinkedList::reverse()
 	std::swap(head, tail);
 	// Clear the boundary conditions
 	head->prev = tail->next = nullptr;
+	reset_finger();
 
 	debug_verfiy_data_integrity();
 }
 
 void LinkedList::merge_2sorted_lists(LinkedList& other)
 {
+	DS_STATS_OP("merge_2sorted_lists");
 	// Merge two sorted lists into one sorted list
 	if (!other.head)
 		return;
+	other.spill_inline_nodes(other.head);
 	if (head) {
 		// Both lists have elements: merge them
 		Node* cur1 = head;
@@ -612,14 +996,20 @@ void LinkedList::merge_2sorted_lists(LinkedList& other)
 
 		// Compare elements and build new sorted list
 		while (cur1 && cur2) {
+			DS_STATS_STEP();
+			// The run that is not taken may wait many steps for its turn:
+			// start loading its next node now (the taken run's next node is
+			// loaded by the following comparison anyway)
 			Node* next{};
 			if (cur1->data <= cur2->data) {
 				next = cur1;
 				cur1 = cur1->next;
+				DS_PREFETCH(cur2->next);
 			}
 			else {
 				next = cur2;
 				cur2 = cur2->next;
+				DS_PREFETCH(cur1->next);
 			}
 			link(last, next);
 			last = next;
@@ -643,14 +1033,309 @@ void LinkedList::merge_2sorted_lists(LinkedList& other)
 	}
 
 	// Update length and debug data
+	DS_STATS_MOVE_NODES(other, other.length, sizeof(Node));
 	length += other.length;
 
-	debug_data.insert(debug_data.end(), other.debug_data.begin(), other.debug_data.end());
+	debug_take_nodes(other);
+	take_arena(other);
+	other.retire_all_handles();
 
 	// Clear the other list (transfer ownership)
 	other.length = 0;
 	other.head = other.tail = nullptr;
-	other.debug_data.clear();
+	reset_finger();
+	other.reset_finger();
 
 	debug_verfiy_data_integrity();
-}
\ No newline at end of file
+}
+
+// A sorted run of nodes: head->...->tail with valid next/prev inside the run
+struct SortRun
+{
+	Node* head{};
+	Node* tail{};
+};
+
+// Merges two sorted runs by relinking (stable: ties keep first before second)
+static SortRun merge_runs(SortRun first, SortRun second)
+{
+	if (!first.head)
+		return second;
+	if (!second.head)
+		return first;
+
+	Node* cur1 = first.head;
+	Node* cur2 = second.head;
+	Node* last{};
+	SortRun ret;
+
+	while (cur1 && cur2) {
+		Node* next;
+		if (cur1->data <= cur2->data) {
+			next = cur1;
+			cur1 = cur1->next;
+		}
+		else {
+			next = cur2;
+			cur2 = cur2->next;
+		}
+		if (last)
+			last->next = next;
+		else
+			ret.head = next;
+		next->prev = last;
+		last = next;
+	}
+
+	// Append the rest of whichever run is left; its tail is the new tail
+	Node* rest = cur1 ? cur1 : cur2;
+	last->next = rest;
+	rest->prev = last;
+	ret.tail = cur1 ? first.tail : second.tail;
+	return ret;
+}
+
+// Bottom-up merge sort of a null-terminated chain, no recursion
+static SortRun sort_run(Node* first)
+{
+	// bins[i] holds a sorted run of 2^i nodes (or is empty)
+	SortRun bins[64];
+	while (first) {
+		SortRun cur{ first, first };
+		first = first->next;
+		cur.head->next = cur.head->prev = nullptr;
+
+		int i = 0;
+		for (; bins[i].head; ++i) {
+			cur = merge_runs(bins[i], cur);
+			bins[i] = SortRun();
+		}
+		bins[i] = cur;
+	}
+
+	// Higher bins hold earlier nodes, so they go first to keep the sort stable
+	SortRun ret;
+	for (int i = 0; i < 64; ++i)
+		if (bins[i].head)
+			ret = merge_runs(bins[i], ret);
+	return ret;
+}
+
+void LinkedList::parallel_sort(int thread_count)
+{
+	DS_STATS_OP("parallel_sort");
+	if (length <= 1)
+		return;
+
+	// Don't spawn threads for tiny runs
+	const int min_run_length = 1024;
+	if (thread_count <= 0)
+		thread_count = std::max(1, (int)std::thread::hardware_concurrency());
+	thread_count = std::max(1, std::min(thread_count, length / min_run_length));
+
+	// Cut the list into thread_count null-terminated chains
+	vector<SortRun> runs(thread_count);
+	Node* cur = head;
+	for (int t = 0; t < thread_count; ++t) {
+		int run_length = length / thread_count + (t < length % thread_count);
+		runs[t].head = cur;
+		for (int i = 1; i < run_length; ++i)
+			cur = cur->next;
+		Node* next = cur->next;
+		cur->next = nullptr;
+		cur = next;
+	}
+
+	// Sort every run on its own thread
+	vector<std::thread> workers;
+	for (int t = 1; t < thread_count; ++t)
+		workers.emplace_back([&runs, t]() { runs[t] = sort_run(runs[t].head); });
+	runs[0] = sort_run(runs[0].head);
+	for (auto& worker : workers)
+		worker.join();
+
+	// Merge neighbouring runs pairwise until one is left
+	while (runs.size() > 1) {
+		vector<SortRun> merged((runs.size() + 1) / 2);
+		workers.clear();
+		for (int i = 1; i < (int)merged.size(); ++i) {
+			if (2 * i + 1 < (int)runs.size())
+				workers.emplace_back([&runs, &merged, i]() { merged[i] = merge_runs(runs[2 * i], runs[2 * i + 1]); });
+			else
+				merged[i] = runs[2 * i];
+		}
+		merged[0] = merge_runs(runs[0], runs[1]);
+		for (auto& worker : workers)
+			worker.join();
+		runs.swap(merged);
+	}
+
+	head = runs[0].head;
+	tail = runs[0].tail;
+	head->prev = tail->next = nullptr;
+	reset_finger();
+
+	debug_verfiy_data_integrity();
+}
+
+void LinkedList::split_after(int n, LinkedList& other)
+{
+	DS_STATS_OP("split_after");
+	// Cut the list after position n and hand the rest to other
+	assert(other.length == 0);
+	if (n < 0 || n >= length)
+		return;
+
+	Node* first_moved = spill_inline_nodes(n ? get_nth_node(n)->next : head);
+	other.head = first_moved;
+	other.tail = tail;
+	other.length = length - n;
+	DS_STATS_GIVE_NODES(other, other.length, sizeof(Node));
+
+	if (n) {
+		tail = first_moved->prev;
+		tail->next = nullptr;
+	}
+	else
+		head = tail = nullptr;
+	first_moved->prev = nullptr;
+	length = n;
+
+	// Move the debug records of the transferred nodes
+	debug_data.clear();
+	for (Node* cur = head; cur; cur = cur->next)
+		debug_add_node(cur);
+	for (Node* cur = other.head; cur; cur = cur->next) {
+		other.debug_add_node(cur);
+		retire_handle(cur);	// handles are per list
+	}
+	// Moved nodes live in our arena blocks
+	other.arena.adopt(arena);
+
+	reset_finger();
+	other.reset_finger();
+	debug_verfiy_data_integrity();
+	other.debug_verfiy_data_integrity();
+}
+
+void LinkedList::append(LinkedList& other)
+{
+	DS_STATS_OP("append");
+	// Concatenate other after our tail
+	if (!other.head)
+		return;
+	other.spill_inline_nodes(other.head);
+	if (!head)
+		head = other.head;
+	else
+		link(tail, other.head);
+	tail = other.tail;
+	DS_STATS_MOVE_NODES(other, other.length, sizeof(Node));
+	length += other.length;
+
+	debug_take_nodes(other);
+	take_arena(other);
+	other.retire_all_handles();
+
+	other.length = 0;
+	other.head = other.tail = nullptr;
+	reset_finger();
+	other.reset_finger();
+
+	debug_verfiy_data_integrity();
+}
+
+//====================================================================================
+// MEMORY LAYOUT FUNCTIONS
+//====================================================================================
+
+double LinkedList::fragmentation() const
+{
+	DS_STATS_OP("fragmentation");
+	// Fraction of links that jump backwards or beyond a few cache lines ahead
+	const std::ptrdiff_t locality_window = 256;	// bytes
+	if (length <= 1)
+		return 0.0;
+	int jumps = 0;
+	for (Node* cur = head; cur->next; cur = cur->next) {
+		DS_STATS_STEP();
+		std::ptrdiff_t distance = (char*)cur->next - (char*)cur;
+		if (distance <= 0 || distance > locality_window)
+			++jumps;
+	}
+	return (double)jumps / (length - 1);
+}
+
+void LinkedList::compact()
+{
+	DS_STATS_OP("compact");
+	// Relocate every node into one array, in list order
+	retire_all_handles();	// the old slots are about to be freed
+	if (!length) {
+		arena.reset();
+		return;
+	}
+
+	// The first block of a fresh arena holds the whole list back to back
+	NodeArena<Node, true> fresh(length);
+	Node* prev = nullptr;
+	for (Node* cur = head; cur; ) {
+		DS_STATS_STEP();
+		Node* next = cur->next;
+		Node* moved = fresh.create(cur->data);
+		link(prev, moved);
+		if (!prev)
+			head = moved;
+
+		// Relocation, not destruction: the old storage is dropped without ~Node()
+		if (is_inline(cur))
+			inline_free |= 1ULL << inline_index(cur);
+
+		prev = moved;
+		cur = next;
+	}
+	tail = prev;
+
+	// Old blocks only held relocated or already destroyed nodes
+	arena.swap(fresh);
+
+	debug_data.clear();
+	for (Node* cur = head; cur; cur = cur->next)
+		debug_add_node(cur);
+	reset_finger();
+
+	debug_verfiy_data_integrity();
+}
+
+bool LinkedList::compact_if_fragmented(double threshold)
+{
+	if (fragmentation() <= threshold)
+		return false;
+	compact();
+	return true;
+}
+
+#ifdef DS_HAS_COROUTINES
+//====================================================================================
+// STREAMING FUNCTIONS
+//====================================================================================
+
+Generator<int> LinkedList::values() const {
+	for (Node* cur = head; cur; cur = cur->next)
+		co_yield cur->data;
+}
+
+Generator<int> LinkedList::reverse_values() const {
+	for (Node* cur = tail; cur; cur = cur->prev)
+		co_yield cur->data;
+}
+
+Generator<Node*> LinkedList::nodes() const {
+	// next is read before yielding, so the consumer may delete the node it was given
+	for (Node* cur = head; cur; ) {
+		Node* next = cur->next;
+		co_yield cur;
+		cur = next;
+	}
+}
+#endif
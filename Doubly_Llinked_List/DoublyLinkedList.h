@@ -1,12 +1,34 @@
 #pragma once
 
 #include "Node.h"
+#include "../Common/ContainerStats.h"
+#include "../Common/NodeArena.h"
+#include "../Common/Generator.h"
 #include <vector>
 #include <string>
+#include <memory>
+#include <thread>
 
 using std::vector;
 using std::string;
 
+/**
+ * @brief Stable reference to a node of a LinkedList
+ *
+ * Returned by the insert functions. It stays valid while the node is in the
+ * list that issued it and survives relinking (swap, reverse, sort). Once the
+ * node is deleted or moved to another list the handle becomes stale, which
+ * the list detects through the generation counter kept in the node's slot,
+ * so issuing a handle allocates nothing. compact() relocates every node and
+ * makes all handles stale, like Node pointers.
+ */
+struct NodeHandle
+{
+	Node* node{};				///< Node the handle refers to (nullptr for a null handle)
+	unsigned generation = 0;	///< Generation of the node's slot when the handle was issued
+	unsigned epoch = 0;			///< The list's handle epoch when the handle was issued
+};
+
 /**
  * @brief A doubly linked list implementation with comprehensive debugging capabilities
  *
@@ -28,6 +50,36 @@ private:
 	Node* head{};		///< Pointer to the first node in the list
 	Node* tail{};		///< Pointer to the last node in the list
 	int length = 0;		///< Current number of nodes in the list
+
+	// Positional access cache - last node returned by get_nth_node
+	Node* finger{};			///< Last node reached by positional access (nullptr if stale)
+	int finger_pos = 0;		///< 1-indexed position of finger
+
+	/**
+	 * @brief Slabs every heap node of this list is allocated from
+	 *
+	 * The memory comes from NodeMemoryResource, so with huge pages or NUMA
+	 * binding enabled there every node of a long list benefits. Blocks are
+	 * shared with the lists this list exchanged nodes with.
+	 */
+	NodeArena<Node, true> arena;
+	typedef NodeArena<Node, true>::Slot NodeSlot;
+
+	// Inline node slots supplied by SmallLinkedList (none for a plain LinkedList)
+	NodeSlot* inline_slots{};			///< First inline slot
+	int inline_capacity = 0;			///< Number of inline slots (at most 64)
+	unsigned long long inline_free = 0;	///< Bit i is set while inline slot i is unused
+
+	/**
+	 * @brief Changes whenever node storage this list handed out may be freed
+	 *
+	 * Handles from an older epoch are stale without reading their node's
+	 * slot, which may no longer exist (after compact() or once all nodes
+	 * went to another list).
+	 */
+	unsigned handle_epoch = 0;
+
+	DS_STATS_MEMBER		///< Memory and operation counters (only with DS_ENABLE_STATS)
 	
 	// Debug support - tracks all nodes for integrity verification	
 	vector<Node*> debug_data;		///< Vector storing pointers to all nodes for debugging
@@ -40,8 +92,100 @@ private:
 	/**
 	 * @brief Removes a node from the debug tracking vector
 	 * @param node Pointer to the node to stop tracking
+	 * @complexity O(1): the last entry takes the node's place
 	 */
 	void debug_remove_node(Node* node);
+	/**
+	 * @brief Moves every debug record of other into this list
+	 * @param other List whose nodes were just linked into this one
+	 */
+	void debug_take_nodes(LinkedList& other);
+
+	/**
+	 * @brief Checks the links around one node, the ends and the length
+	 * @param node Node that was just inserted, or a neighbour of a removed one (may be nullptr)
+	 *
+	 * The O(1) counterpart of debug_verfiy_data_integrity() for operations
+	 * that only touch a few nodes. Compiled out with NDEBUG.
+	 */
+	void debug_verify_around(Node* node);
+
+	/**
+	 * @brief Forgets the cached finger after the list shape changes
+	 */
+	void reset_finger();
+
+	/**
+	 * @brief Allocates a node for a new value
+	 * @param val Value to store
+	 * @return Newly created node
+	 */
+	Node* create_node(int val);
+
+	/**
+	 * @brief Destroys a node and gives its slot back to the inline slots or the arena
+	 * @param node Node to destroy
+	 */
+	void release_node(Node* node);
+
+	/**
+	 * @brief Checks whether a node lives in the inline slots
+	 */
+	bool is_inline(Node* node) const;
+
+	/**
+	 * @brief Index of an inline node's slot
+	 */
+	int inline_index(Node* node) const;
+
+	/**
+	 * @brief Moves the inline nodes from first up to the tail to the arena
+	 *
+	 * Inline storage dies with this object, so it is called before nodes are
+	 * handed over to another list. Handles to the moved nodes become stale.
+	 *
+	 * @return The node now at first's position
+	 */
+	Node* spill_inline_nodes(Node* first);
+
+	/**
+	 * @brief Takes over all nodes' storage from other, whose nodes now belong to this list
+	 *
+	 * Shares other's arena blocks, so that whichever list deletes the nodes
+	 * last still owns their storage, and leaves other with an empty arena.
+	 */
+	void take_arena(LinkedList& other);
+
+	/**
+	 * @brief Reclaims a batch of already unlinked nodes
+	 *
+	 * Updates length and debug tracking once for the whole batch, then
+	 * destroys the nodes and gives their slots back to the arena.
+	 *
+	 * @param removed Unlinked nodes
+	 */
+	void release_batch(vector<Node*>& removed);
+
+	/**
+	 * @brief Invalidates the handles of a node leaving this list
+	 */
+	void retire_handle(Node* node);
+
+	/**
+	 * @brief Invalidates every handle issued by this list, in O(1)
+	 *
+	 * Used when all nodes are handed over to another list or relocated.
+	 */
+	void retire_all_handles();
+
+protected:
+	/**
+	 * @brief Creates an empty list that places its first nodes in caller storage
+	 * @param inline_slots Value-initialized slots for inline_capacity nodes; must
+	 *        outlive the list (SmallLinkedList keeps them in a base class)
+	 * @param inline_capacity Number of inline slots, 1 - 64
+	 */
+	LinkedList(NodeSlot* inline_slots, int inline_capacity);
 
 public:
 	/**
@@ -96,6 +240,8 @@ public:
 	 * - Forward and backward traversal integrity
 	 * - Debug vector synchronization
 	 *
+	 * Walks the whole list; compiled out with NDEBUG.
+	 *
 	 * @throws Assertion error if inconsistency is found
 	 */
 	void   debug_verfiy_data_integrity();
@@ -152,26 +298,87 @@ public:
 	 * @brief Helper function to insert a new node after a given node
 	 * @param node_before Pointer to the node after which to insert
 	 * @param val Value to insert
+	 * @return The new node
 	 */
-	void embed_after(Node* node_before, int val);
+	Node* embed_after(Node* node_before, int val);
 
 	/**
 	 * @brief Inserts a new node at the end of the list
 	 * @param val Value to insert
+	 * @return Handle to the new node
 	 */
-	void insert_end(int val);
+	NodeHandle insert_end(int val);
 
 	/**
 	 * @brief Inserts a new node at the beginning of the list
 	 * @param val Value to insert
+	 * @return Handle to the new node
 	 */
-	void insert_front(int val);
+	NodeHandle insert_front(int val);
 
 	/**
 	 * @brief Inserts a value in sorted order (assumes list is already sorted)
 	 * @param val Value to insert in correct sorted position
+	 * @return Handle to the new node
+	 */
+	NodeHandle insert_sorted(int val);
+
+	/**
+	 * @brief Inserts a value so that it becomes the nth node (1-indexed)
+	 * @param n Target position, 1..length + 1 (other values are ignored)
+	 * @param val Value to insert
+	 * @return Handle to the new node, or a null handle if n is out of range
+	 */
+	NodeHandle insert_at(int n, int val);
+
+	/**
+	 * @brief Inserts a value right before the node referenced by a handle
+	 * @param pos Handle issued by this list
+	 * @param val Value to insert
+	 * @return Handle to the new node, or a null handle if pos is stale
+	 * @complexity O(1)
+	 */
+	NodeHandle insert_before(NodeHandle pos, int val);
+
+	/**
+	 * @brief Inserts a value right after the node referenced by a handle
+	 * @param pos Handle issued by this list
+	 * @param val Value to insert
+	 * @return Handle to the new node, or a null handle if pos is stale
+	 * @complexity O(1)
+	 */
+	NodeHandle insert_after(NodeHandle pos, int val);
+
+	//====================================================================================
+	// HANDLE FUNCTIONS
+	//====================================================================================
+
+	/**
+	 * @brief Gets a handle to a node of this list
+	 * @param node Node in this list (e.g. from get_nth_node)
+	 * @return Handle to the node
+	 * @complexity O(1), no allocation
+	 */
+	NodeHandle handle_of(Node* node);
+
+	/**
+	 * @brief Checks whether a handle still refers to a node in this list
+	 */
+	bool is_valid(NodeHandle handle) const;
+
+	/**
+	 * @brief Gets the node a handle refers to
+	 * @return The node, or nullptr if the handle is stale
+	 */
+	Node* resolve(NodeHandle handle) const;
+
+	/**
+	 * @brief Deletes the node referenced by a handle
+	 * @param handle Handle issued by this list
+	 * @return True if a node was deleted, false if the handle was stale
+	 * @complexity O(1)
 	 */
-	void insert_sorted(int val);
+	bool erase(NodeHandle handle);
 
 	//====================================================================================
 	// DELETION FUNCTIONS
@@ -206,6 +413,18 @@ public:
 	 */
 	void delete_all_nodes_with_key(int val);
 
+	/**
+	 * @brief Deletes every node whose value satisfies a predicate
+	 *
+	 * Unlinks all matching nodes in a single traversal and reclaims them as
+	 * one batch instead of one debug/bookkeeping update per node.
+	 *
+	 * @param pred Callable taking the node value and returning true to delete it
+	 * @return Number of nodes removed
+	 */
+	template <typename Predicate>
+	int erase_if(Predicate pred);
+
 	/**
 	 * @brief Deletes all nodes at even positions (2nd, 4th, 6th, etc.) - Version 1
 	 */
@@ -226,6 +445,12 @@ public:
 	 */
 	void delete_odd_positions2();
 
+	/**
+	 * @brief Deletes the nth node from the beginning (1-indexed)
+	 * @param n Position to delete (out-of-range values are ignored)
+	 */
+	void delete_nth_node(int n);
+
 	//====================================================================================
 	// ANALYSIS FUNCTIONS
 	//====================================================================================
@@ -254,20 +479,64 @@ public:
 	// ACCESS FUNCTIONS
 	//====================================================================================
 
+	/**
+	 * @brief Gets the current number of nodes
+	 * @return Number of nodes in the list
+	 */
+	int get_length() const;
+
+	/**
+	 * @brief Gets the memory and operation counters (only with DS_ENABLE_STATS)
+	 */
+	DS_STATS_ACCESSOR
+
 	/**
 	 * @brief Gets the nth node from the beginning (1-indexed)
+	 *
+	 * Walks from whichever of head, tail or the last accessed node is
+	 * closest, so the worst case is length / 2 steps and nearby accesses
+	 * are almost free.
+	 *
 	 * @param n Position from the start (1 = first node)
-	 * @return Pointer to the nth node, or nullptr if n > length
+	 * @return Pointer to the nth node, or nullptr if n <= 0 or n > length
 	 */
 	Node* get_nth_node(int n);
 
 	/**
 	 * @brief Gets the nth node from the end (1-indexed)
 	 * @param n Position from the end (1 = last node)
-	 * @return Pointer to the nth node from end, or nullptr if n > length
+	 * @return Pointer to the nth node from end, or nullptr if n <= 0 or n > length
 	 */
 	Node* get_nth_node_back(int n);
 
+	/**
+	 * @brief Finds the first occurrence of many values in one traversal
+	 *
+	 * One cursor walks forward from head and one backward from tail, and
+	 * they meet in the middle. The two pointer chains do not depend on each
+	 * other, so each step has two node loads in flight, and a lookup is never
+	 * more than length / 2 steps deep. The walk stops early once the forward
+	 * cursor has found every value.
+	 *
+	 * @param vals Values to search for
+	 * @return 1-based position of each value's first occurrence, or -1 if not found
+	 * @complexity O(n + k) time - O(k) memory
+	 */
+	vector<int> search_batch(const vector<int>& vals);
+
+	/**
+	 * @brief Gets the nodes at many positions in one traversal
+	 *
+	 * Positions in the first half are served by a cursor walking forward
+	 * from head and the rest by one walking backward from tail, advanced in
+	 * the same loop so their loads overlap.
+	 *
+	 * @param positions 1-based positions, in any order
+	 * @return The node at each position, or nullptr if out of range
+	 * @complexity O(n + k log k) time - O(k) memory
+	 */
+	vector<Node*> get_nth_batch(const vector<int>& positions);
+
 	//====================================================================================
 	// ADVANCED MANIPULATION FUNCTIONS
 	//====================================================================================
@@ -300,4 +569,123 @@ public:
 	 */
 	void merge_2sorted_lists(LinkedList& other);
 
-};
\ No newline at end of file
+	/**
+	 * @brief Sorts the list in ascending order using several threads
+	 *
+	 * The list is cut into one run per thread, each run is merge sorted by
+	 * relinking its nodes, and the runs are merged pairwise in parallel
+	 * until one remains. Nodes are never copied; prev links are fixed up
+	 * during the merges. The sort is stable.
+	 *
+	 * @param thread_count Number of threads, 0 = hardware concurrency
+	 */
+	void parallel_sort(int thread_count = 0);
+
+	/**
+	 * @brief Moves every node after position n to the (empty) other list
+	 *
+	 * Nodes are relinked, not copied. Afterwards this list holds the first
+	 * n nodes and other holds the rest in the same order.
+	 *
+	 * @param n Number of nodes to keep (0..length)
+	 * @param other Empty list receiving the remaining nodes
+	 */
+	void split_after(int n, LinkedList& other);
+
+	/**
+	 * @brief Moves all nodes of other to the end of this list in O(1) links
+	 * @param other List to append; becomes empty
+	 */
+	void append(LinkedList& other);
+
+	//====================================================================================
+	// MEMORY LAYOUT FUNCTIONS
+	//====================================================================================
+
+	/**
+	 * @brief Measures how scattered the nodes are in memory
+	 *
+	 * Counts the links whose next node lies behind the current one or more
+	 * than a few cache lines ahead of it.
+	 *
+	 * @return 0.0 when a forward scan walks memory sequentially, up to 1.0
+	 *         when every link jumps somewhere else in the heap
+	 */
+	double fragmentation() const;
+
+	/**
+	 * @brief Relocates all nodes into one contiguous block in list order
+	 *
+	 * Rewires next/prev so that forward and backward scans touch memory
+	 * sequentially. Node pointers and handles obtained earlier become
+	 * invalid. The block is the first of a fresh arena, so nodes inserted
+	 * later go to slots freed by deletions first and then to new blocks
+	 * after it.
+	 */
+	void compact();
+
+	/**
+	 * @brief Compacts only when fragmentation() is above a threshold
+	 * @param threshold Fragmentation level that triggers compaction (0.0 - 1.0)
+	 * @return true if the list was compacted
+	 */
+	bool compact_if_fragmented(double threshold = 0.5);
+
+#ifdef DS_HAS_COROUTINES
+	//====================================================================================
+	// STREAMING FUNCTIONS - C++20 generators, O(1) memory
+	//====================================================================================
+
+	/**
+	 * @brief Streams the values from head to tail
+	 *
+	 * Nothing is copied up front; combine with the pipeline:: stages of
+	 * Generator.h to filter, map, take or chunk lazily. The list must not be
+	 * modified while the generator is suspended mid-traversal.
+	 */
+	Generator<int> values() const;
+
+	/**
+	 * @brief Streams the values from tail to head
+	 */
+	Generator<int> reverse_values() const;
+
+	/**
+	 * @brief Streams the nodes from head to tail
+	 *
+	 * The consumer may delete the node it was just given (and only that one).
+	 */
+	Generator<Node*> nodes() const;
+#endif
+
+};
+
+//====================================================================================
+// TEMPLATE MEMBER DEFINITIONS
+//====================================================================================
+
+template <typename Predicate>
+int LinkedList::erase_if(Predicate pred)
+{
+	// Unlink every match in one pass, reclaim them together afterwards
+	DS_STATS_OP("erase_if");
+	vector<Node*> removed;
+	for (Node* cur = head; cur; ) {
+		DS_STATS_STEP();
+		Node* next = cur->next;
+		if (pred(cur->data)) {
+			if (cur == head)
+				head = next;
+			if (cur == tail)
+				tail = cur->prev;
+			link(cur->prev, next);
+			removed.push_back(cur);
+		}
+		cur = next;
+	}
+
+	int count = (int)removed.size();
+	if (count)
+		release_batch(removed);
+	return count;
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+/**
+ * @brief Links embedded in a user object so it can be threaded onto an IntrusiveList
+ *
+ * A type that should live in N lists at once embeds N hooks. The hook
+ * unlinks itself when the owning object is destroyed, so a list never
+ * keeps a dangling pointer to a dead object.
+ */
+struct ListHook
+{
+	ListHook* next{};	///< Next hook in the list (nullptr if not linked)
+	ListHook* prev{};	///< Previous hook in the list (nullptr if not linked)
+
+	ListHook() {}
+
+	// Copying an object must not copy its list membership
+	ListHook(const ListHook&) {}
+	ListHook& operator=(const ListHook&) { return *this; }
+
+	/**
+	 * @brief Auto-unlink: leaves whatever list the owner is in
+	 */
+	~ListHook() {
+		unlink();
+	}
+
+	/**
+	 * @brief Checks whether the hook is currently in a list
+	 */
+	bool is_linked() const {
+		return next != nullptr;
+	}
+
+	/**
+	 * @brief Removes the hook from its list (no-op if not linked)
+	 */
+	void unlink() {
+		if (!next)
+			return;
+		next->prev = prev;
+		prev->next = next;
+		next = prev = nullptr;
+	}
+};
+
+/**
+ * @brief Doubly linked list of objects that embed a ListHook
+ *
+ * The list never allocates and never owns its elements: it links the
+ * hooks that already live inside the user objects, so an object from a
+ * pool can be put on a list with no extra allocation and no extra pointer
+ * hop to reach its data.
+ *
+ * The list is circular around a sentinel hook, which lets any element
+ * unlink itself without knowing which list it is in. Because elements can
+ * leave on their own (auto-unlink), the size is counted on demand.
+ *
+ * @tparam T Element type
+ * @tparam Hook Pointer to the ListHook member of T used by this list
+ *
+ * Example:
+ * @code
+ * struct Task { int id; ListHook ready_hook; ListHook all_hook; };
+ * IntrusiveList<Task, &Task::ready_hook> ready;
+ * IntrusiveList<Task, &Task::all_hook> all;
+ * @endcode
+ */
+template <typename T, ListHook T::*Hook>
+class IntrusiveList {
+private:
+	ListHook sentinel;	///< sentinel.next is the first hook, sentinel.prev the last
+
+	static ListHook* hook_of(T& item) {
+		return &(item.*Hook);
+	}
+
+	/**
+	 * @brief Recovers the owning object from a pointer to its hook
+	 */
+	static T* owner_of(ListHook* hook) {
+		if (hook == nullptr)
+			return nullptr;
+		return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - hook_offset());
+	}
+
+	static std::ptrdiff_t hook_offset() {
+		// Byte distance from the start of T to the hook member
+		alignas(T) static char probe[sizeof(T)];
+		T* object = reinterpret_cast<T*>(probe);
+		return reinterpret_cast<char*>(&(object->*Hook)) - reinterpret_cast<char*>(object);
+	}
+
+	/**
+	 * @brief Links item's hook between two adjacent hooks
+	 */
+	static void embed_between(ListHook* before, ListHook* after, T& item) {
+		ListHook* hook = hook_of(item);
+		assert(!hook->is_linked());	// one hook can only be in one list
+		hook->prev = before;
+		hook->next = after;
+		before->next = hook;
+		after->prev = hook;
+	}
+
+public:
+	/**
+	 * @brief Forward iterator over the linked objects
+	 */
+	class iterator {
+	private:
+		ListHook* cur{};
+	public:
+		iterator(ListHook* cur) :cur(cur) {}
+		T& operator*() const { return *owner_of(cur); }
+		T* operator->() const { return owner_of(cur); }
+		iterator& operator++() { cur = cur->next; return *this; }
+		bool operator==(const iterator& other) const { return cur == other.cur; }
+		bool operator!=(const iterator& other) const { return cur != other.cur; }
+	};
+
+	IntrusiveList() {
+		sentinel.next = sentinel.prev = &sentinel;
+	}
+
+	/**
+	 * @brief Unlinks every element; the objects themselves are untouched
+	 */
+	~IntrusiveList() {
+		clear();
+		sentinel.next = sentinel.prev = nullptr;
+	}
+
+	// The sentinel's address is shared with the elements, so the list cannot be copied
+	IntrusiveList(const IntrusiveList&) = delete;
+	IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+	iterator begin() { return iterator(sentinel.next); }
+	iterator end() { return iterator(&sentinel); }
+
+	bool is_empty() const {
+		return sentinel.next == &sentinel;
+	}
+
+	/**
+	 * @brief Counts the linked elements
+	 * @return Number of elements, O(n) since elements may unlink themselves
+	 */
+	int size() const {
+		int len = 0;
+		for (ListHook* cur = sentinel.next; cur != &sentinel; cur = cur->next)
+			++len;
+		return len;
+	}
+
+	/**
+	 * @brief Links an object at the beginning of the list
+	 */
+	void insert_front(T& item) {
+		embed_between(&sentinel, sentinel.next, item);
+	}
+
+	/**
+	 * @brief Links an object at the end of the list
+	 */
+	void insert_end(T& item) {
+		embed_between(sentinel.prev, &sentinel, item);
+	}
+
+	/**
+	 * @brief Links item right after pos (pos must be in this list)
+	 */
+	void insert_after(T& pos, T& item) {
+		ListHook* before = hook_of(pos);
+		embed_between(before, before->next, item);
+	}
+
+	/**
+	 * @brief Links item right before pos (pos must be in this list)
+	 */
+	void insert_before(T& pos, T& item) {
+		ListHook* after = hook_of(pos);
+		embed_between(after->prev, after, item);
+	}
+
+	/**
+	 * @brief Unlinks an object that is in this list
+	 */
+	void erase(T& item) {
+		hook_of(item)->unlink();
+	}
+
+	/**
+	 * @brief First object, or nullptr if the list is empty
+	 */
+	T* front() {
+		return is_empty() ? nullptr : owner_of(sentinel.next);
+	}
+
+	/**
+	 * @brief Last object, or nullptr if the list is empty
+	 */
+	T* back() {
+		return is_empty() ? nullptr : owner_of(sentinel.prev);
+	}
+
+	/**
+	 * @brief Object after item, or nullptr if item is the last one
+	 */
+	T* next(T& item) {
+		ListHook* hook = hook_of(item)->next;
+		return hook == &sentinel ? nullptr : owner_of(hook);
+	}
+
+	/**
+	 * @brief Object before item, or nullptr if item is the first one
+	 */
+	T* prev(T& item) {
+		ListHook* hook = hook_of(item)->prev;
+		return hook == &sentinel ? nullptr : owner_of(hook);
+	}
+
+	/**
+	 * @brief Unlinks and returns the first object (nullptr if empty)
+	 */
+	T* delete_front() {
+		T* item = front();
+		if (item)
+			erase(*item);
+		return item;
+	}
+
+	/**
+	 * @brief Unlinks and returns the last object (nullptr if empty)
+	 */
+	T* delete_end() {
+		T* item = back();
+		if (item)
+			erase(*item);
+		return item;
+	}
+
+	/**
+	 * @brief Unlinks every element
+	 */
+	void clear() {
+		while (!is_empty())
+			sentinel.next->unlink();
+	}
+};
@@ -0,0 +1,547 @@
+#pragma once
+
+#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cassert>
+
+/**
+ * @brief Counters reported by the cache engines
+ */
+struct CacheStats
+{
+	long long hits{};		///< Lookups that found the key
+	long long misses{};		///< Lookups that did not find the key
+	long long evictions{};	///< Entries dropped to make room for new ones
+
+	CacheStats& operator+=(const CacheStats& other) {
+		hits += other.hits;
+		misses += other.misses;
+		evictions += other.evictions;
+		return *this;
+	}
+};
+
+/**
+ * @brief Least-recently-used cache built on a doubly linked recency list
+ *
+ * The recency list uses the same head/tail + link() layout as LinkedList:
+ * the head is the most recently used entry and the tail is the next one to
+ * be evicted. A hash index maps every key to its node, so get/put/erase
+ * never walk the list.
+ *
+ * Features:
+ * - O(1) get, put and erase
+ * - Capacity-based eviction of the least recently used entry
+ * - Hit/miss/eviction counters
+ *
+ * Not thread-safe on its own; wrap it in ShardedCache for concurrent use.
+ */
+template <typename K, typename V>
+class LruCache {
+private:
+	struct Node
+	{
+		K key;
+		V value;
+		Node* next{};
+		Node* prev{};
+		Node(const K& key, const V& value) :key(key), value(value) {}
+	};
+
+	Node* head{};		///< Most recently used entry
+	Node* tail{};		///< Least recently used entry (evicted first)
+	int length = 0;		///< Current number of entries
+	int capacity{};		///< Maximum number of entries
+
+	std::unordered_map<K, Node*> index;	///< key -> node in the recency list
+	CacheStats stats;
+
+	/**
+	 * @brief Links two nodes bidirectionally, handling nullptr cases
+	 */
+	void link(Node* first, Node* second) {
+		if (first)
+			first->next = second;
+		if (second)
+			second->prev = first;
+	}
+
+	/**
+	 * @brief Detaches a node from the recency list without deleting it
+	 * @param cur Node to detach
+	 */
+	void unlink(Node* cur) {
+		if (cur == head)
+			head = cur->next;
+		if (cur == tail)
+			tail = cur->prev;
+		link(cur->prev, cur->next);
+		cur->next = cur->prev = nullptr;
+	}
+
+	/**
+	 * @brief Makes a detached node the most recently used one
+	 * @param cur Node to attach at the head
+	 */
+	void attach_front(Node* cur) {
+		link(cur, head);
+		head = cur;
+		if (!tail)
+			tail = cur;
+	}
+
+	/**
+	 * @brief Drops the least recently used entry
+	 */
+	void evict() {
+		Node* victim = tail;
+		unlink(victim);
+		index.erase(victim->key);
+		delete victim;
+		--length;
+		++stats.evictions;
+	}
+
+public:
+	/**
+	 * @brief Creates an empty cache
+	 * @param capacity Maximum number of entries (must be positive)
+	 */
+	LruCache(int capacity) :capacity(capacity) {
+		assert(capacity > 0);
+		index.reserve(capacity);
+	}
+
+	~LruCache() {
+		clear();
+	}
+
+	// Nodes are owned by the cache, so copying would alias them
+	LruCache(const LruCache&) = delete;
+	LruCache& operator=(const LruCache&) = delete;
+
+	/**
+	 * @brief Looks up a key and marks it as most recently used
+	 * @param key Key to search for
+	 * @param value Receives the cached value on a hit
+	 * @return true on a hit, false on a miss
+	 */
+	bool get(const K& key, V& value) {
+		auto it = index.find(key);
+		if (it == index.end()) {
+			++stats.misses;
+			return false;
+		}
+		++stats.hits;
+		Node* cur = it->second;
+		if (cur != head) {
+			unlink(cur);
+			attach_front(cur);
+		}
+		value = cur->value;
+		return true;
+	}
+
+	/**
+	 * @brief Inserts or updates a key, evicting the LRU entry when full
+	 * @param key Key to store
+	 * @param value Value to associate with the key
+	 */
+	void put(const K& key, const V& value) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			Node* cur = it->second;
+			cur->value = value;
+			if (cur != head) {
+				unlink(cur);
+				attach_front(cur);
+			}
+			return;
+		}
+		if (length == capacity)
+			evict();
+
+		Node* item = new Node(key, value);
+		attach_front(item);
+		index.emplace(key, item);
+		++length;
+	}
+
+	/**
+	 * @brief Removes a key from the cache
+	 * @param key Key to remove
+	 * @return true if the key was present
+	 */
+	bool erase(const K& key) {
+		auto it = index.find(key);
+		if (it == index.end())
+			return false;
+		Node* cur = it->second;
+		index.erase(it);
+		unlink(cur);
+		delete cur;
+		--length;
+		return true;
+	}
+
+	/**
+	 * @brief Checks for a key without touching recency or counters
+	 */
+	bool contains(const K& key) const {
+		return index.count(key) != 0;
+	}
+
+	/**
+	 * @brief Deletes every entry (counters are kept)
+	 */
+	void clear() {
+		while (head) {
+			Node* next = head->next;
+			delete head;
+			head = next;
+		}
+		tail = nullptr;
+		length = 0;
+		index.clear();
+	}
+
+	int size() const { return length; }
+
+	int get_capacity() const { return capacity; }
+
+	CacheStats get_stats() const { return stats; }
+
+	void reset_stats() { stats = CacheStats(); }
+};
+
+/**
+ * @brief Least-frequently-used cache with O(1) frequency buckets
+ *
+ * Entries with the same access count live in one bucket, and the buckets
+ * form a doubly linked list ordered by frequency. Each bucket is itself a
+ * doubly linked recency list, so ties are broken by evicting the least
+ * recently used entry of the lowest-frequency bucket.
+ *
+ * Not thread-safe on its own; wrap it in ShardedCache for concurrent use.
+ */
+template <typename K, typename V>
+class LfuCache {
+private:
+	struct Bucket;
+
+	struct Node
+	{
+		K key;
+		V value;
+		Node* next{};
+		Node* prev{};
+		Bucket* bucket{};	///< Bucket holding every entry with the same frequency
+		Node(const K& key, const V& value) :key(key), value(value) {}
+	};
+
+	struct Bucket
+	{
+		long long freq{};
+		Node* head{};		///< Most recently used entry with this frequency
+		Node* tail{};		///< Least recently used entry with this frequency
+		Bucket* next{};		///< Next higher frequency
+		Bucket* prev{};		///< Next lower frequency
+		Bucket(long long freq) :freq(freq) {}
+	};
+
+	Bucket* head{};		///< Lowest-frequency bucket (eviction happens here)
+	int length = 0;
+	int capacity{};
+
+	std::unordered_map<K, Node*> index;
+	CacheStats stats;
+
+	template <typename T>
+	static void link(T* first, T* second) {
+		if (first)
+			first->next = second;
+		if (second)
+			second->prev = first;
+	}
+
+	/**
+	 * @brief Inserts a new bucket right after node_before (or as head)
+	 */
+	Bucket* embed_bucket_after(Bucket* node_before, long long freq) {
+		Bucket* item = new Bucket(freq);
+		if (!node_before) {
+			link(item, head);
+			head = item;
+		}
+		else {
+			Bucket* node_after = node_before->next;
+			link(node_before, item);
+			link(item, node_after);
+		}
+		return item;
+	}
+
+	/**
+	 * @brief Deletes a bucket once its last entry left
+	 */
+	void delete_bucket(Bucket* bucket) {
+		if (bucket == head)
+			head = bucket->next;
+		link(bucket->prev, bucket->next);
+		delete bucket;
+	}
+
+	void attach_front(Bucket* bucket, Node* cur) {
+		cur->prev = nullptr;
+		link(cur, bucket->head);
+		bucket->head = cur;
+		if (!bucket->tail)
+			bucket->tail = cur;
+		cur->bucket = bucket;
+	}
+
+	/**
+	 * @brief Detaches a node from its bucket, deleting the bucket if empty
+	 */
+	void unlink(Node* cur) {
+		Bucket* bucket = cur->bucket;
+		if (cur == bucket->head)
+			bucket->head = cur->next;
+		if (cur == bucket->tail)
+			bucket->tail = cur->prev;
+		link(cur->prev, cur->next);
+		cur->next = cur->prev = nullptr;
+		cur->bucket = nullptr;
+
+		if (!bucket->head)
+			delete_bucket(bucket);
+	}
+
+	/**
+	 * @brief Moves an entry to the bucket of frequency + 1
+	 */
+	void touch(Node* cur) {
+		Bucket* bucket = cur->bucket;
+		long long freq = bucket->freq + 1;
+		Bucket* target = bucket->next;
+
+		if (!target || target->freq != freq) {
+			// No bucket for freq + 1 yet
+			if (bucket->head == cur && bucket->tail == cur) {
+				bucket->freq = freq;	// sole entry: reuse the bucket in place
+				return;
+			}
+			target = embed_bucket_after(bucket, freq);
+		}
+		unlink(cur);
+		attach_front(target, cur);
+	}
+
+	void evict() {
+		Node* victim = head->tail;
+		unlink(victim);
+		index.erase(victim->key);
+		delete victim;
+		--length;
+		++stats.evictions;
+	}
+
+public:
+	/**
+	 * @brief Creates an empty cache
+	 * @param capacity Maximum number of entries (must be positive)
+	 */
+	LfuCache(int capacity) :capacity(capacity) {
+		assert(capacity > 0);
+		index.reserve(capacity);
+	}
+
+	~LfuCache() {
+		clear();
+	}
+
+	LfuCache(const LfuCache&) = delete;
+	LfuCache& operator=(const LfuCache&) = delete;
+
+	/**
+	 * @brief Looks up a key and bumps its access frequency
+	 * @return true on a hit, false on a miss
+	 */
+	bool get(const K& key, V& value) {
+		auto it = index.find(key);
+		if (it == index.end()) {
+			++stats.misses;
+			return false;
+		}
+		++stats.hits;
+		touch(it->second);
+		value = it->second->value;
+		return true;
+	}
+
+	/**
+	 * @brief Inserts or updates a key, evicting the LFU entry when full
+	 */
+	void put(const K& key, const V& value) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			it->second->value = value;
+			touch(it->second);
+			return;
+		}
+		if (length == capacity)
+			evict();
+
+		Node* item = new Node(key, value);
+		Bucket* bucket = head && head->freq == 1 ? head : embed_bucket_after(nullptr, 1);
+		attach_front(bucket, item);
+		index.emplace(key, item);
+		++length;
+	}
+
+	/**
+	 * @brief Removes a key from the cache
+	 * @return true if the key was present
+	 */
+	bool erase(const K& key) {
+		auto it = index.find(key);
+		if (it == index.end())
+			return false;
+		Node* cur = it->second;
+		index.erase(it);
+		unlink(cur);
+		delete cur;
+		--length;
+		return true;
+	}
+
+	bool contains(const K& key) const {
+		return index.count(key) != 0;
+	}
+
+	/**
+	 * @brief Access frequency of a key, or 0 if it is not cached
+	 */
+	long long frequency(const K& key) const {
+		auto it = index.find(key);
+		return it == index.end() ? 0 : it->second->bucket->freq;
+	}
+
+	void clear() {
+		while (head) {
+			for (Node* cur = head->head; cur; ) {
+				Node* next = cur->next;
+				delete cur;
+				cur = next;
+			}
+			Bucket* next = head->next;
+			delete head;
+			head = next;
+		}
+		length = 0;
+		index.clear();
+	}
+
+	int size() const { return length; }
+
+	int get_capacity() const { return capacity; }
+
+	CacheStats get_stats() const { return stats; }
+
+	void reset_stats() { stats = CacheStats(); }
+};
+
+/**
+ * @brief Splits keys across independent cache shards, each with its own lock
+ *
+ * Every shard is a full Engine (LruCache or LfuCache) holding capacity / shards
+ * entries. Threads touching different shards never contend. Locking can be
+ * turned off for single-threaded use, in which case the wrapper only adds
+ * the shard selection.
+ *
+ * @tparam Engine LruCache or LfuCache
+ */
+template <typename K, typename V, template <typename, typename> class Engine = LruCache>
+class ShardedCache {
+private:
+	struct Shard
+	{
+		std::mutex mtx;
+		Engine<K, V> cache;
+		Shard(int capacity) :cache(capacity) {}
+	};
+
+	std::vector<std::unique_ptr<Shard>> shards;
+	bool is_locked{};
+
+	Shard& shard_for(const K& key) {
+		return *shards[std::hash<K>()(key) % shards.size()];
+	}
+
+public:
+	/**
+	 * @param capacity Total number of entries across all shards
+	 * @param shard_count Number of independent shards
+	 * @param is_locked Whether each shard is protected by its own mutex
+	 */
+	ShardedCache(int capacity, int shard_count = 16, bool is_locked = true) :is_locked(is_locked) {
+		assert(shard_count > 0 && capacity >= shard_count);
+		int per_shard = (capacity + shard_count - 1) / shard_count;
+		for (int i = 0; i < shard_count; ++i)
+			shards.emplace_back(new Shard(per_shard));
+	}
+
+	bool get(const K& key, V& value) {
+		Shard& shard = shard_for(key);
+		if (!is_locked)
+			return shard.cache.get(key, value);
+		std::lock_guard<std::mutex> guard(shard.mtx);
+		return shard.cache.get(key, value);
+	}
+
+	void put(const K& key, const V& value) {
+		Shard& shard = shard_for(key);
+		if (!is_locked) {
+			shard.cache.put(key, value);
+			return;
+		}
+		std::lock_guard<std::mutex> guard(shard.mtx);
+		shard.cache.put(key, value);
+	}
+
+	bool erase(const K& key) {
+		Shard& shard = shard_for(key);
+		if (!is_locked)
+			return shard.cache.erase(key);
+		std::lock_guard<std::mutex> guard(shard.mtx);
+		return shard.cache.erase(key);
+	}
+
+	int size() {
+		int total = 0;
+		for (auto& shard : shards) {
+			std::unique_lock<std::mutex> guard(shard->mtx, std::defer_lock);
+			if (is_locked)
+				guard.lock();
+			total += shard->cache.size();
+		}
+		return total;
+	}
+
+	/**
+	 * @brief Sums the counters of every shard
+	 */
+	CacheStats get_stats() {
+		CacheStats total;
+		for (auto& shard : shards) {
+			std::unique_lock<std::mutex> guard(shard->mtx, std::defer_lock);
+			if (is_locked)
+				guard.lock();
+			total += shard->cache.get_stats();
+		}
+		return total;
+	}
+};
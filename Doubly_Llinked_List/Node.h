@@ -15,6 +15,7 @@
 struct Node
 {
 	int data{};		///< The integer value stored in this node
+	int debug_index = -1;	///< Position in the owning list's debug_data (-1 if untracked)
 	Node* next{};	///< Pointer to the next node in the list (nullptr if last)
 	Node* prev{};	///< Pointer to the previous node in the list (nullptr if first)
 
@@ -0,0 +1,294 @@
+#include "OrderStatisticList.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <new>
+#include <sstream>
+#define el '\n'
+
+using std::cout;
+
+//====================================================================================
+// CONSTRUCTORS AND DESTRUCTOR
+//====================================================================================
+
+OrderStatisticList::OrderStatisticList(unsigned seed) :random(seed) {
+	// Sentinel: every level starts empty, so each link spans one past the end
+	head = create_node(0, max_level);
+}
+
+OrderStatisticList::~OrderStatisticList() {
+	SkipNode* cur = head;
+	while (cur) {
+		SkipNode* next = cur->links()[0].next;
+		release_node(cur);
+		cur = next;
+	}
+	head = tail = nullptr;
+	length = 0;
+}
+
+//====================================================================================
+// NODE MANAGEMENT
+//====================================================================================
+
+OrderStatisticList::SkipNode* OrderStatisticList::create_node(int val, int height) {
+	void* memory = ::operator new(sizeof(SkipNode) + sizeof(Link) * height);
+	SkipNode* node = new (memory) SkipNode();
+	node->data = val;
+	node->height = height;
+	for (int i = 0; i < height; ++i)
+		new (node->links() + i) Link();
+	return node;
+}
+
+void OrderStatisticList::release_node(SkipNode* node) {
+	// SkipNode and Link are trivially destructible
+	::operator delete(node);
+}
+
+int OrderStatisticList::random_height() {
+	// One random word gives up to 32 coin flips
+	unsigned bits = random();
+	int height = 1;
+	while (height < max_level && (bits & 1)) {
+		++height;
+		bits >>= 1;
+	}
+	return height;
+}
+
+//====================================================================================
+// INSERTION AND DELETION
+//====================================================================================
+
+void OrderStatisticList::insert(int val) {
+	// For every level: last node before the new one, and its position
+	SkipNode* update[max_level];
+	int position[max_level];
+
+	SkipNode* cur = head;
+	int pos = 0;
+	for (int i = level - 1; i >= 0; --i) {
+		while (cur->links()[i].next && cur->links()[i].next->data <= val) {
+			pos += cur->links()[i].width;
+			cur = cur->links()[i].next;
+		}
+		update[i] = cur;
+		position[i] = pos;
+	}
+
+	int height = random_height();
+	for (int i = level; i < height; ++i) {
+		// New levels start at the sentinel, spanning the whole list
+		update[i] = head;
+		position[i] = 0;
+		head->links()[i].width = length + 1;
+	}
+	level = std::max(level, height);
+
+	// The new node takes position pos + 1
+	SkipNode* item = create_node(val, height);
+	for (int i = 0; i < height; ++i) {
+		Link& before = update[i]->links()[i];
+		int skipped = pos - position[i];	// steps from update[i] to the new node's predecessor
+		item->links()[i].next = before.next;
+		item->links()[i].width = before.width - skipped;
+		before.next = item;
+		before.width = skipped + 1;
+	}
+	for (int i = height; i < level; ++i)
+		++update[i]->links()[i].width;	// one more node under these links
+
+	// Bottom level back link
+	item->prev = update[0] == head ? nullptr : update[0];
+	SkipNode* after = item->links()[0].next;
+	if (after)
+		after->prev = item;
+	else
+		tail = item;
+	++length;
+}
+
+bool OrderStatisticList::erase(int val) {
+	SkipNode* update[max_level];
+	SkipNode* cur = head;
+	for (int i = level - 1; i >= 0; --i) {
+		while (cur->links()[i].next && cur->links()[i].next->data < val)
+			cur = cur->links()[i].next;
+		update[i] = cur;
+	}
+
+	SkipNode* target = cur->links()[0].next;
+	if (!target || target->data != val)
+		return false;
+
+	for (int i = 0; i < level; ++i) {
+		Link& before = update[i]->links()[i];
+		if (before.next == target) {
+			before.width += target->links()[i].width - 1;
+			before.next = target->links()[i].next;
+		}
+		else
+			--before.width;	// the link jumps over target
+	}
+
+	SkipNode* after = target->links()[0].next;
+	if (after)
+		after->prev = target->prev;
+	else
+		tail = target->prev;
+	release_node(target);
+	--length;
+
+	// Drop levels that became empty
+	while (level > 1 && !head->links()[level - 1].next) {
+		head->links()[level - 1].width = 1;
+		--level;
+	}
+	return true;
+}
+
+//====================================================================================
+// ORDER-STATISTIC QUERIES
+//====================================================================================
+
+int OrderStatisticList::get_length() const {
+	return length;
+}
+
+bool OrderStatisticList::is_empty() const {
+	return length == 0;
+}
+
+int OrderStatisticList::count_less(int val, bool inclusive) const {
+	const SkipNode* cur = head;
+	int pos = 0;
+	for (int i = level - 1; i >= 0; --i) {
+		for (const SkipNode* next = cur->links()[i].next;
+			next && (next->data < val || (inclusive && next->data == val));
+			next = cur->links()[i].next) {
+			pos += cur->links()[i].width;
+			cur = next;
+		}
+	}
+	return pos;
+}
+
+bool OrderStatisticList::contains(int val) const {
+	int less = count_less(val, false);
+	return less < length && select(less + 1) == val;
+}
+
+int OrderStatisticList::select(int k) const {
+	assert(1 <= k && k <= length);
+	const SkipNode* cur = head;
+	int pos = 0;
+	for (int i = level - 1; i >= 0; --i) {
+		while (cur->links()[i].next && pos + cur->links()[i].width <= k) {
+			pos += cur->links()[i].width;
+			cur = cur->links()[i].next;
+		}
+		if (pos == k)
+			break;
+	}
+	return cur->data;
+}
+
+int OrderStatisticList::rank(int val) const {
+	return count_less(val, false);
+}
+
+int OrderStatisticList::count_range(int lo, int hi) const {
+	if (lo > hi)
+		return 0;
+	return count_less(hi, true) - count_less(lo, false);
+}
+
+double OrderStatisticList::median() const {
+	assert(length > 0);
+	if (length % 2)
+		return select(length / 2 + 1);
+	return (select(length / 2) + (double)select(length / 2 + 1)) / 2;
+}
+
+int OrderStatisticList::percentile(double p) const {
+	assert(length > 0);
+	int k = (int)std::ceil(p / 100 * length);
+	if (k < 1)
+		k = 1;
+	if (k > length)
+		k = length;
+	return select(k);
+}
+
+int OrderStatisticList::min() const {
+	assert(length > 0);
+	return head->links()[0].next->data;
+}
+
+int OrderStatisticList::max() const {
+	assert(length > 0);
+	return tail->data;
+}
+
+//====================================================================================
+// DISPLAY AND DEBUG
+//====================================================================================
+
+void OrderStatisticList::print() const {
+	for (const SkipNode* cur = head->links()[0].next; cur; cur = cur->links()[0].next)
+		cout << cur->data << " ";
+	cout << el;
+}
+
+void OrderStatisticList::print_reverse() const {
+	for (const SkipNode* cur = tail; cur; cur = cur->prev)
+		cout << cur->data << " ";
+	cout << el;
+}
+
+string OrderStatisticList::debug_to_string() const {
+	std::ostringstream oss;
+	for (const SkipNode* cur = head->links()[0].next; cur; cur = cur->links()[0].next) {
+		oss << cur->data;
+		if (cur->links()[0].next)
+			oss << " ";
+	}
+	return oss.str();
+}
+
+void OrderStatisticList::debug_verify_data_integrity() const {
+	// Bottom level: order, back links, tail and length
+	int len = 0;
+	const SkipNode* prev = nullptr;
+	for (const SkipNode* cur = head->links()[0].next; cur; prev = cur, cur = cur->links()[0].next, ++len) {
+		assert(cur->prev == prev);
+		assert(cur->height >= 1 && cur->height <= level);
+		if (prev)
+			assert(prev->data <= cur->data);
+	}
+	assert(tail == prev);
+	assert(len == length);
+
+#ifndef NDEBUG
+	// Every link's width equals the positions it skips (one past the end for the last link)
+	for (int i = 0; i < level; ++i) {
+		const SkipNode* from = head;
+		int from_pos = 0;
+		int pos = 0;
+		for (const SkipNode* cur = head->links()[0].next; cur; cur = cur->links()[0].next) {
+			++pos;
+			if (cur->height > i) {
+				assert(from->links()[i].next == cur);
+				assert(from->links()[i].width == pos - from_pos);
+				from = cur;
+				from_pos = pos;
+			}
+		}
+		assert(!from->links()[i].next);
+		assert(from->links()[i].width == length + 1 - from_pos);
+	}
+#endif
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <random>
+#include <string>
+
+using std::string;
+
+/**
+ * @brief Sorted doubly linked list with O(log n) order-statistic queries
+ *
+ * The bottom level is an ordinary sorted doubly linked list (next/prev,
+ * head to tail), as built by LinkedList::insert_sorted. On top of it each
+ * node gets a random number of express links (an indexable skip list):
+ * a node climbs each extra level with probability 1/2, and every link stores its
+ * width, the number of bottom-level steps it skips. Searches start on the
+ * highest level and drop down, so they touch O(log n) nodes on average,
+ * and summing the widths along the way gives positions for free.
+ *
+ * Features:
+ * - insert / erase in sorted order, O(log n)
+ * - select(k): k-th smallest value, O(log n)
+ * - rank(value) and count_range(lo, hi), O(log n)
+ * - median() and percentile(p), O(log n)
+ * - min / max, O(1)
+ *
+ * Example:
+ * @code
+ * OrderStatisticList latencies;
+ * for (int ms : samples)
+ *     latencies.insert(ms);
+ * int p99 = latencies.percentile(99);
+ * int slow = latencies.count_range(500, 1000);
+ * @endcode
+ */
+class OrderStatisticList {
+private:
+	static const int max_level = 32;
+
+	struct SkipNode;
+
+	/**
+	 * @brief Express link of one level
+	 */
+	struct Link
+	{
+		SkipNode* next{};	///< Next node on this level (nullptr if last)
+		int width = 1;		///< Bottom-level steps to next (to one past the end if next is nullptr)
+	};
+
+	/**
+	 * @brief List node; links()[0] is the bottom level, links()[height - 1] the top
+	 *
+	 * The links are allocated in the same block, right after the node, so a
+	 * node costs one allocation whatever its height.
+	 */
+	struct SkipNode
+	{
+		int data{};			///< The integer value stored in this node
+		int height{};		///< Number of levels the node is linked on
+		SkipNode* prev{};	///< Previous node on the bottom level (nullptr if first)
+
+		Link* links() { return reinterpret_cast<Link*>(this + 1); }
+		const Link* links() const { return reinterpret_cast<const Link*>(this + 1); }
+	};
+
+	SkipNode* head{};		///< Sentinel holding max_level links, no value
+	SkipNode* tail{};		///< Last node (nullptr if empty)
+	int length = 0;			///< Number of values
+	int level = 1;			///< Levels currently in use
+	std::mt19937 random;	///< Source of node heights
+
+	/**
+	 * @brief Allocates a node with its links in one block
+	 */
+	static SkipNode* create_node(int val, int height);
+
+	/**
+	 * @brief Destroys a node created by create_node
+	 */
+	static void release_node(SkipNode* node);
+
+	/**
+	 * @brief Draws a height: level i is reached with probability 1/2^(i-1)
+	 */
+	int random_height();
+
+	/**
+	 * @brief Counts the values smaller than val (or not greater when inclusive)
+	 */
+	int count_less(int val, bool inclusive) const;
+
+public:
+	/**
+	 * @brief Creates an empty list
+	 * @param seed Seed of the node height generator (fixed seeds give reproducible layouts)
+	 */
+	OrderStatisticList(unsigned seed = 5489u);
+
+	/**
+	 * @brief Destructor - deletes every node
+	 */
+	~OrderStatisticList();
+
+	// Disable copy operations to prevent shallow copying issues
+	OrderStatisticList(const OrderStatisticList&) = delete;
+	OrderStatisticList& operator=(const OrderStatisticList&) = delete;
+
+	int get_length() const;
+
+	bool is_empty() const;
+
+	/**
+	 * @brief Inserts a value in sorted order, after existing equal values
+	 * @complexity O(log n) expected
+	 */
+	void insert(int val);
+
+	/**
+	 * @brief Deletes one occurrence of a value
+	 * @return True if a node was deleted
+	 * @complexity O(log n) expected
+	 */
+	bool erase(int val);
+
+	/**
+	 * @brief Checks whether a value is in the list
+	 * @complexity O(log n) expected
+	 */
+	bool contains(int val) const;
+
+	/**
+	 * @brief Gets the k-th smallest value (1-indexed, list must hold at least k values)
+	 * @complexity O(log n) expected
+	 */
+	int select(int k) const;
+
+	/**
+	 * @brief Number of values strictly smaller than val
+	 *
+	 * rank(val) + 1 is the position val has or would get, so
+	 * select(rank(val) + 1) is the first value not smaller than val.
+	 *
+	 * @complexity O(log n) expected
+	 */
+	int rank(int val) const;
+
+	/**
+	 * @brief Number of values in [lo, hi] (0 if lo > hi)
+	 * @complexity O(log n) expected
+	 */
+	int count_range(int lo, int hi) const;
+
+	/**
+	 * @brief Median value; the mean of the two middle values for even lengths
+	 * @complexity O(log n) expected
+	 */
+	double median() const;
+
+	/**
+	 * @brief Nearest-rank percentile: smallest value with at least p% of values at or below it
+	 * @param p Percentile in (0, 100]; values outside are clamped to the first or last value
+	 * @complexity O(log n) expected
+	 */
+	int percentile(double p) const;
+
+	/**
+	 * @brief Smallest value (list must not be empty), O(1)
+	 */
+	int min() const;
+
+	/**
+	 * @brief Largest value (list must not be empty), O(1)
+	 */
+	int max() const;
+
+	void print() const;
+
+	void print_reverse() const;
+
+	/**
+	 * @brief Converts the list to a space-separated string representation
+	 */
+	string debug_to_string() const;
+
+	/**
+	 * @brief Verifies order, prev links, tail, length and every link width
+	 */
+	void debug_verify_data_integrity() const;
+};
@@ -0,0 +1,266 @@
+#include "RcuLinkedList.h"
+#include <cassert>
+#include <sstream>
+#include <thread>
+
+//====================================================================================
+// CONSTRUCTORS AND DESTRUCTOR
+//====================================================================================
+
+RcuLinkedList::RcuLinkedList(int reclaim_batch) :reclaim_batch(reclaim_batch) {
+	assert(reclaim_batch > 0);
+}
+
+RcuLinkedList::~RcuLinkedList() {
+	// No readers are left, so nothing needs a grace period
+	RcuNode* cur = head.load();
+	while (cur) {
+		RcuNode* next = cur->next.load();
+		delete cur;
+		cur = next;
+	}
+	for (RcuNode* node : retired)
+		delete node;
+	retired.clear();
+}
+
+//====================================================================================
+// EPOCH AND RECLAMATION
+//====================================================================================
+
+RcuLinkedList::ReaderShard& RcuLinkedList::reader_shard() const {
+	// Threads are spread round-robin over the shards on first use
+	static std::atomic<int> next_shard{ 0 };
+	static thread_local int shard = next_shard.fetch_add(1) % shard_count;
+	return readers[shard];
+}
+
+RcuLinkedList::ReadGuard::ReadGuard(const RcuLinkedList& list) :shard(list.reader_shard()) {
+	parity = list.epoch.load();
+	shard.active[parity].fetch_add(1);
+}
+
+RcuLinkedList::ReadGuard::~ReadGuard() {
+	// Release: everything this reader loaded happens before the writer sees it leave
+	shard.active[parity].fetch_sub(1, std::memory_order_release);
+}
+
+void RcuLinkedList::wait_for_readers() {
+	// Order the unlinking stores before the reader counters are inspected
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Two flips: a reader that read the parity just before a flip may register
+	// under the old parity late, so both parities must drain once
+	for (int flip = 0; flip < 2; ++flip) {
+		int old_parity = epoch.load();
+		epoch.store(old_parity ^ 1);
+		for (ReaderShard& shard : readers)
+			while (shard.active[old_parity].load() != 0)
+				std::this_thread::yield();
+	}
+}
+
+void RcuLinkedList::reclaim_retired() {
+	if (retired.empty())
+		return;
+	wait_for_readers();
+	for (RcuNode* node : retired)
+		delete node;
+	retired.clear();
+}
+
+//====================================================================================
+// WRITER FUNCTIONS
+//====================================================================================
+
+void RcuLinkedList::embed_between(RcuNode* before, RcuNode* after, RcuNode* item) {
+	// Fill the new node first, then publish it with release stores
+	item->prev.store(before, std::memory_order_relaxed);
+	item->next.store(after, std::memory_order_relaxed);
+	if (after)
+		after->prev.store(item, std::memory_order_release);
+	else
+		tail.store(item, std::memory_order_release);
+	if (before)
+		before->next.store(item, std::memory_order_release);
+	else
+		head.store(item, std::memory_order_release);
+	length.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RcuLinkedList::unlink(RcuNode* node) {
+	// Bypass the node; its own links stay intact for readers standing on it
+	RcuNode* before = node->prev.load(std::memory_order_relaxed);
+	RcuNode* after = node->next.load(std::memory_order_relaxed);
+	if (before)
+		before->next.store(after, std::memory_order_release);
+	else
+		head.store(after, std::memory_order_release);
+	if (after)
+		after->prev.store(before, std::memory_order_release);
+	else
+		tail.store(before, std::memory_order_release);
+	length.fetch_sub(1, std::memory_order_relaxed);
+
+	retired.push_back(node);
+	if ((int)retired.size() >= reclaim_batch)
+		reclaim_retired();
+}
+
+void RcuLinkedList::insert_front(int val) {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	embed_between(nullptr, head.load(std::memory_order_relaxed), new RcuNode(val));
+}
+
+void RcuLinkedList::insert_end(int val) {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	embed_between(tail.load(std::memory_order_relaxed), nullptr, new RcuNode(val));
+}
+
+void RcuLinkedList::insert_sorted(int val) {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	// Writers hold the lock, so relaxed loads see the latest links
+	RcuNode* after = head.load(std::memory_order_relaxed);
+	RcuNode* before = nullptr;
+	while (after && after->data < val) {
+		before = after;
+		after = after->next.load(std::memory_order_relaxed);
+	}
+	embed_between(before, after, new RcuNode(val));
+}
+
+void RcuLinkedList::delete_front() {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	RcuNode* first = head.load(std::memory_order_relaxed);
+	if (first)
+		unlink(first);
+}
+
+void RcuLinkedList::delete_end() {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	RcuNode* last = tail.load(std::memory_order_relaxed);
+	if (last)
+		unlink(last);
+}
+
+bool RcuLinkedList::delete_node_with_key(int val) {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	for (RcuNode* cur = head.load(std::memory_order_relaxed); cur; cur = cur->next.load(std::memory_order_relaxed)) {
+		if (cur->data == val) {
+			unlink(cur);
+			return true;
+		}
+	}
+	return false;
+}
+
+void RcuLinkedList::synchronize() {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	reclaim_retired();
+}
+
+int RcuLinkedList::get_pending_reclaim() const {
+	std::lock_guard<std::mutex> lock(writer_lock);
+	return (int)retired.size();
+}
+
+//====================================================================================
+// READER FUNCTIONS
+//====================================================================================
+
+int RcuLinkedList::get_length() const {
+	return length.load();
+}
+
+bool RcuLinkedList::search(int val) const {
+	ReadGuard guard(*this);
+	for (RcuNode* cur = head.load(); cur; cur = cur->next.load())
+		if (cur->data == val)
+			return true;
+	return false;
+}
+
+bool RcuLinkedList::get_nth(int n, int& out) const {
+	if (n <= 0)
+		return false;
+	ReadGuard guard(*this);
+	RcuNode* cur = head.load();
+	while (cur && --n)
+		cur = cur->next.load();
+	if (!cur)
+		return false;
+	out = cur->data;
+	return true;
+}
+
+bool RcuLinkedList::find_the_middle(int& out) const {
+	// Tortoise and hare: a single forward walk, no length snapshot needed
+	ReadGuard guard(*this);
+	RcuNode* slow = head.load();
+	if (!slow)
+		return false;
+	RcuNode* fast = slow;
+	while (fast) {
+		RcuNode* next = fast->next.load();
+		if (!next)
+			break;
+		slow = slow->next.load();
+		fast = next->next.load();
+	}
+	out = slow->data;
+	return true;
+}
+
+bool RcuLinkedList::is_palindrome() const {
+	// Compare nodes from both ends moving inward
+	ReadGuard guard(*this);
+	int steps = length.load() / 2;
+	RcuNode* h = head.load();
+	RcuNode* t = tail.load();
+	if (!h)
+		return false;
+	while (steps-- && h && t) {
+		if (h->data != t->data)
+			return false;
+		h = h->next.load();
+		t = t->prev.load();
+	}
+	return true;
+}
+
+vector<int> RcuLinkedList::to_vector() const {
+	vector<int> values;
+	for_each([&values](int value) { values.push_back(value); });
+	return values;
+}
+
+string RcuLinkedList::debug_to_string() const {
+	std::ostringstream oss;
+	for_each([&oss](int value) {
+		if (oss.tellp() > 0)
+			oss << " ";
+		oss << value;
+	});
+	return oss.str();
+}
+
+void RcuLinkedList::debug_verify_data_integrity() const {
+#ifndef NDEBUG
+	RcuNode* first = head.load();
+	RcuNode* last = tail.load();
+	assert(!first == !last);
+	if (!first)
+		return;
+	assert(!first->prev.load() && !last->next.load());
+
+	int len = 0;
+	for (RcuNode* cur = first; cur; cur = cur->next.load(), ++len) {
+		RcuNode* next = cur->next.load();
+		if (next)
+			assert(next->prev.load() == cur);
+		else
+			assert(cur == last);
+	}
+	assert(len == length.load());
+#endif
+}
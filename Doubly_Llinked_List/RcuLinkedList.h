@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <string>
+
+using std::vector;
+using std::string;
+
+/**
+ * @brief Doubly linked list with lock-free readers protected by RCU epochs
+ *
+ * Writers are serialized by one mutex and publish every link change with a
+ * release store. Readers never take that mutex: they announce themselves in
+ * an epoch counter, walk the next/prev pointers, and leave. A node that a
+ * writer unlinks keeps its own next/prev pointers, so a reader standing on
+ * it can still move on, and its memory is reclaimed only after every reader
+ * that could have reached it has left (read-copy-update).
+ *
+ * Reader counters are split into padded shards so readers on different
+ * cores do not bounce the same cache line, and each shard counts readers
+ * per epoch parity. A grace period flips the parity twice and waits for
+ * the old parity to drain each time.
+ *
+ * Readers see every single link consistently, but a traversal that
+ * overlaps writes may see some changes and not others; results are exact
+ * whenever no writer runs at the same time.
+ *
+ * Features:
+ * - Lock-free search, get_nth, find_the_middle, is_palindrome and traversal
+ * - Writer operations mirror LinkedList (insert/delete front/end/sorted/key)
+ * - Batched reclamation of unlinked nodes, or explicit synchronize()
+ *
+ * A thread must not call a writer function while it holds a ReadGuard:
+ * the writer would wait for its own read section to finish.
+ */
+class RcuLinkedList {
+private:
+	struct RcuNode
+	{
+		int data{};
+		std::atomic<RcuNode*> next{ nullptr };
+		std::atomic<RcuNode*> prev{ nullptr };
+		RcuNode(int data) :data(data) {}
+	};
+
+	/**
+	 * @brief Reader counters of one shard, one per epoch parity
+	 */
+	struct alignas(64) ReaderShard
+	{
+		std::atomic<int> active[2];
+		ReaderShard() { active[0] = active[1] = 0; }
+	};
+
+	static const int shard_count = 16;
+
+	std::atomic<RcuNode*> head{ nullptr };	///< First node
+	std::atomic<RcuNode*> tail{ nullptr };	///< Last node
+	std::atomic<int> length{ 0 };			///< Number of linked nodes
+
+	mutable std::mutex writer_lock;			///< Serializes writers
+	mutable ReaderShard readers[shard_count];
+	std::atomic<int> epoch{ 0 };			///< Parity new readers register under
+
+	vector<RcuNode*> retired;	///< Unlinked nodes waiting for a grace period
+	int reclaim_batch{};		///< Grace period is run once this many nodes are retired
+
+	/**
+	 * @brief Shard used by the calling thread (fixed per thread)
+	 */
+	ReaderShard& reader_shard() const;
+
+	/**
+	 * @brief Links item between two adjacent nodes (either may be nullptr)
+	 */
+	void embed_between(RcuNode* before, RcuNode* after, RcuNode* item);
+
+	/**
+	 * @brief Unlinks a node and queues it for reclamation
+	 */
+	void unlink(RcuNode* node);
+
+	/**
+	 * @brief Waits until every reader that started before the call has left
+	 */
+	void wait_for_readers();
+
+	/**
+	 * @brief Runs a grace period and frees every retired node
+	 */
+	void reclaim_retired();
+
+public:
+	/**
+	 * @brief Read-side critical section; nodes seen inside it stay allocated
+	 *
+	 * Cheap to enter and leave: one atomic increment and one decrement on
+	 * the calling thread's shard.
+	 */
+	class ReadGuard {
+	private:
+		ReaderShard& shard;
+		int parity;
+	public:
+		ReadGuard(const RcuLinkedList& list);
+		~ReadGuard();
+		ReadGuard(const ReadGuard&) = delete;
+		ReadGuard& operator=(const ReadGuard&) = delete;
+	};
+
+	/**
+	 * @brief Creates an empty list
+	 * @param reclaim_batch Retired nodes collected before a grace period runs
+	 */
+	RcuLinkedList(int reclaim_batch = 64);
+
+	/**
+	 * @brief Deletes all nodes (no reader or writer may still be active)
+	 */
+	~RcuLinkedList();
+
+	// Disable copy operations to prevent shallow copying issues
+	RcuLinkedList(const RcuLinkedList&) = delete;
+	RcuLinkedList& operator=(const RcuLinkedList&) = delete;
+
+	//====================================================================================
+	// WRITER FUNCTIONS - serialized by the writer lock
+	//====================================================================================
+
+	void insert_front(int val);
+	void insert_end(int val);
+
+	/**
+	 * @brief Inserts a value in sorted order (assumes list is already sorted)
+	 */
+	void insert_sorted(int val);
+
+	void delete_front();
+	void delete_end();
+
+	/**
+	 * @brief Deletes the first occurrence of a value
+	 * @return True if a node was deleted
+	 */
+	bool delete_node_with_key(int val);
+
+	/**
+	 * @brief Waits for current readers and frees every retired node now
+	 */
+	void synchronize();
+
+	/**
+	 * @brief Number of unlinked nodes not yet freed
+	 */
+	int get_pending_reclaim() const;
+
+	//====================================================================================
+	// READER FUNCTIONS - lock-free, safe to call from any thread
+	//====================================================================================
+
+	/**
+	 * @brief Gets the number of nodes, O(1)
+	 */
+	int get_length() const;
+
+	/**
+	 * @brief Checks whether a value is in the list
+	 */
+	bool search(int val) const;
+
+	/**
+	 * @brief Gets the value of the nth node from the beginning (1-indexed)
+	 * @return False if the list has fewer than n nodes
+	 */
+	bool get_nth(int n, int& out) const;
+
+	/**
+	 * @brief Gets the middle value (second middle for even lengths)
+	 * @return False if the list is empty
+	 */
+	bool find_the_middle(int& out) const;
+
+	/**
+	 * @brief Checks whether the values read the same in both directions
+	 */
+	bool is_palindrome() const;
+
+	/**
+	 * @brief Calls f(value) for every node from first to last
+	 */
+	template <typename Function>
+	void for_each(Function f) const;
+
+	/**
+	 * @brief Copies the values from first to last
+	 */
+	vector<int> to_vector() const;
+
+	/**
+	 * @brief Converts the list to a space-separated string representation
+	 */
+	string debug_to_string() const;
+
+	/**
+	 * @brief Verifies links and length (call only while no writer is active)
+	 */
+	void debug_verify_data_integrity() const;
+};
+
+//====================================================================================
+// TEMPLATE MEMBER DEFINITIONS
+//====================================================================================
+
+template <typename Function>
+void RcuLinkedList::for_each(Function f) const
+{
+	ReadGuard guard(*this);
+	for (RcuNode* cur = head.load(); cur; cur = cur->next.load())
+		f(cur->data);
+}
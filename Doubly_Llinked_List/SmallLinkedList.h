@@ -0,0 +1,61 @@
+#pragma once
+
+#include "DoublyLinkedList.h"
+
+/**
+ * @brief Storage for N nodes, kept in a base class of SmallLinkedList
+ *
+ * Base classes are constructed before and destroyed after the bases that
+ * follow them, so the storage is valid for the whole life of the LinkedList
+ * part that places nodes in it. The slots have the arena's layout, so
+ * inline nodes carry a handle generation like heap nodes.
+ */
+template <int N>
+struct InlineNodeStorage
+{
+	NodeArena<Node, true>::Slot inline_storage[N];
+
+	InlineNodeStorage() :inline_storage() {}	// generations start at 0
+};
+
+/**
+ * @brief LinkedList that keeps its first N nodes inside the list object
+ *
+ * A short list needs no heap node at all: nodes are constructed in inline
+ * slots and go back to them when deleted. Once more than N nodes are alive
+ * the extra ones are allocated on the heap as usual, and freed inline slots
+ * are reused by the next insertions.
+ *
+ * All LinkedList operations are available unchanged. Nodes handed over to
+ * another list (merge_2sorted_lists, append, split_after) are moved to the
+ * heap first, because the inline slots die with this object.
+ *
+ * The object is about N * sizeof(Node) bytes larger than a LinkedList, so
+ * keep N small (the default 8 covers most short lists). Do not delete it
+ * through a LinkedList pointer: the destructor is not virtual.
+ *
+ * Example:
+ * @code
+ * SmallLinkedList<> list;		// 8 inline nodes
+ * list.insert_end(1);			// no heap allocation for the node
+ * @endcode
+ */
+template <int N = 8>
+class SmallLinkedList : private InlineNodeStorage<N>, public LinkedList {
+	static_assert(0 < N && N <= 64, "SmallLinkedList supports 1 to 64 inline nodes");
+public:
+	/**
+	 * @brief Creates an empty list with N free inline slots
+	 */
+	SmallLinkedList() :LinkedList(this->inline_storage, N) {}
+
+	SmallLinkedList(const SmallLinkedList&) = delete;
+	SmallLinkedList& operator=(const SmallLinkedList&) = delete;
+
+	/**
+	 * @brief Number of nodes the list holds without heap allocation
+	 */
+	static int get_inline_capacity() {
+		return N;
+	}
+};
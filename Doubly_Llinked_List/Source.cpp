@@ -1,4 +1,14 @@
 #include "DoublyLinkedList.h"
+#include "LruCache.h"
+#include "TieredList.h"
+#include "IntrusiveList.h"
+#include "ConcurrentDeque.h"
+#include "RcuLinkedList.h"
+#include "SmallLinkedList.h"
+#include "OrderStatisticList.h"
+#include <algorithm>
+#include <thread>
+#include <chrono>
 #define FAST ios_base::sync_with_stdio(0), cout.tie(0), cin.tie(0)
 #define el '\n'
 using namespace std;
@@ -286,6 +296,35 @@ void test_deletion_functions() {
         );
     }
 
+    // Test erase_if
+    {
+        LinkedList list;
+        TestHelper::populate_list(list, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+        int removed = list.erase_if([](int data) { return data % 2 == 0 || data == 1; });
+        TestFramework::assert_test(
+            removed == 6 && TestHelper::verify_list_contents(list, { 3, 5, 7, 9 }),
+            "erase_if removes head, middle and tail matches"
+        );
+
+        list.insert_end(11);
+        list.insert_front(1);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 1, 3, 5, 7, 9, 11 }),
+            "erase_if keeps head and tail usable"
+        );
+
+        removed = list.erase_if([](int data) { return data > 4; });
+        TestFramework::assert_test(
+            removed == 4 && TestHelper::verify_list_contents(list, { 1, 3 }),
+            "erase_if removes a run at the tail"
+        );
+
+        TestFramework::assert_test(
+            list.erase_if([](int) { return false; }) == 0 && list.get_length() == 2,
+            "erase_if with no matches leaves the list unchanged"
+        );
+    }
+
     // Test delete_even_positions
     {
         LinkedList list1, list2;
@@ -447,6 +486,86 @@ void test_access_functions() {
         list.get_nth_node_back(6) == nullptr,
         "get_nth_node_back(6) returns nullptr for out-of-bounds"
     );
+
+    // Test non-positive positions
+    TestFramework::assert_test(
+        list.get_nth_node(0) == nullptr && list.get_nth_node(-3) == nullptr,
+        "get_nth_node returns nullptr for n <= 0"
+    );
+    TestFramework::assert_test(
+        list.get_nth_node_back(0) == nullptr && list.get_nth_node_back(-1) == nullptr,
+        "get_nth_node_back returns nullptr for n <= 0"
+    );
+
+    // Test mixed access order (nearest end / cached position)
+    {
+        bool all_match = true;
+        int order[] = { 4, 2, 5, 1, 3, 3, 4 };
+        for (int n : order)
+            all_match = all_match && list.get_nth_node(n)->data == n * 10;
+        TestFramework::assert_test(all_match, "get_nth_node correct for any access order");
+    }
+
+    // Test positions stay correct after the list changes
+    {
+        LinkedList other;
+        TestHelper::populate_list(other, { 1, 2, 3, 4, 5, 6 });
+        other.get_nth_node(4);
+        other.delete_front();
+        other.insert_end(7);
+        TestFramework::assert_test(
+            other.get_nth_node(4)->data == 5 && other.get_nth_node_back(2)->data == 6,
+            "get_nth_node correct after insert/delete"
+        );
+        other.reverse();
+        TestFramework::assert_test(
+            other.get_nth_node(4)->data == 4 && other.get_nth_node(5)->data == 3,
+            "get_nth_node correct after reverse"
+        );
+    }
+
+    // Test batched lookups (both ends walked at once)
+    {
+        TestFramework::assert_test(
+            list.search_batch({ 50, 99, 20, 10, 30, 20 }) == vector<int>({ 5, -1, 2, 1, 3, 2 }),
+            "search_batch finds values in both halves"
+        );
+        vector<Node*> nodes = list.get_nth_batch({ 6, 0, 2, 5, 3, 2, 1, -1, 4 });
+        TestFramework::assert_test(
+            !nodes[0] && !nodes[1] && !nodes[7] && nodes[2] == nodes[5] && nodes[2]->data == 20 &&
+            nodes[3]->data == 50 && nodes[4]->data == 30 && nodes[6]->data == 10 && nodes[8]->data == 40,
+            "get_nth_batch returns nodes in request order, nullptr when out of range"
+        );
+        TestFramework::assert_test(
+            list.search_batch({}).empty() && list.get_nth_batch({}).empty(),
+            "batched lookups with no requests"
+        );
+
+        // Duplicates in either half must report the first occurrence
+        bool all_match = true;
+        for (int size = 0; size <= 7; ++size) {
+            LinkedList other;
+            vector<int> values;
+            for (int i = 0; i < size; ++i) {
+                values.push_back(i % 3);
+                other.insert_end(i % 3);
+            }
+            vector<int> expected;
+            for (int val = 0; val < 4; ++val) {
+                auto it = std::find(values.begin(), values.end(), val);
+                expected.push_back(it == values.end() ? -1 : int(it - values.begin()) + 1);
+            }
+            all_match = all_match && other.search_batch({ 0, 1, 2, 3 }) == expected;
+
+            vector<int> positions;
+            for (int n = size + 1; n >= 0; --n)
+                positions.push_back(n);
+            vector<Node*> found = other.get_nth_batch(positions);
+            for (int k = 0; k < (int)positions.size(); ++k)
+                all_match = all_match && found[k] == other.get_nth_node(positions[k]);
+        }
+        TestFramework::assert_test(all_match, "batched lookups match single lookups for lists of 0 to 7 nodes");
+    }
 }
 
 //====================================================================================
@@ -514,6 +633,53 @@ void test_manipulation_functions() {
         );
     }
 
+    {
+        LinkedList list;
+        TestHelper::populate_list(list, { 1, 2, 3, 4, 5 });
+        list.swap_kth(5);  // Same pair as k = 1
+        list.swap_kth(0);  // Ignored
+        list.swap_kth(9);  // Ignored
+        list.swap_forward_with_backword(-1);  // Ignored
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 5, 2, 3, 4, 1 }),
+            "swap_kth handles k = length and out-of-range k"
+        );
+    }
+
+    // Test parallel_sort
+    {
+        LinkedList list;
+        list.parallel_sort();   // empty list
+        TestHelper::populate_list(list, { 5, -1, 3, 3, 0 });
+        list.parallel_sort(4);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { -1, 0, 3, 3, 5 }),
+            "parallel_sort sorts a small list"
+        );
+    }
+
+    {
+        LinkedList list;
+        std::vector<int> expected;
+        unsigned seed = 12345;
+        for (int i = 0; i < 5000; ++i) {
+            seed = seed * 1103515245 + 12345;
+            int val = (int)((seed >> 16) % 1000) - 500;
+            list.insert_end(val);
+            expected.push_back(val);
+        }
+        std::sort(expected.begin(), expected.end());
+        list.parallel_sort(4);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, expected),
+            "parallel_sort sorts a large list across threads"
+        );
+        TestFramework::assert_test(
+            list.get_nth_node_back(1)->data == expected.back() && list.get_nth_node(2500)->data == expected[2499],
+            "parallel_sort keeps prev links and tail consistent"
+        );
+    }
+
     // Test merge_2sorted_lists
     {
         LinkedList list1, list2;
@@ -625,6 +791,1050 @@ void test_edge_cases() {
     }
 }
 
+//====================================================================================
+// CACHE TESTS
+//====================================================================================
+
+void test_cache_functions() {
+    cout << "\n=== CACHE TESTS ===" << el;
+
+    // Test LRU eviction order
+    {
+        LruCache<int, int> cache(2);
+        int value = 0;
+        cache.put(1, 10);
+        cache.put(2, 20);
+        cache.get(1, value);        // 1 becomes most recent
+        cache.put(3, 30);           // evicts 2
+        TestFramework::assert_test(
+            cache.contains(1) && !cache.contains(2) && cache.contains(3),
+            "LruCache evicts least recently used entry"
+        );
+        TestFramework::assert_test(
+            cache.get(3, value) && value == 30 && !cache.get(2, value),
+            "LruCache get returns cached value and misses evicted key"
+        );
+
+        CacheStats stats = cache.get_stats();
+        TestFramework::assert_test(
+            stats.hits == 2 && stats.misses == 1 && stats.evictions == 1,
+            "LruCache tracks hits, misses and evictions"
+        );
+    }
+
+    // Test LRU update and erase
+    {
+        LruCache<int, string> cache(2);
+        string value;
+        cache.put(1, "a");
+        cache.put(2, "b");
+        cache.put(1, "c");          // update refreshes recency
+        cache.put(3, "d");          // evicts 2
+        TestFramework::assert_test(
+            cache.get(1, value) && value == "c" && !cache.contains(2),
+            "LruCache put updates value and recency"
+        );
+        TestFramework::assert_test(
+            cache.erase(1) && !cache.erase(1) && cache.size() == 1,
+            "LruCache erase removes key once"
+        );
+    }
+
+    // Test LFU eviction order
+    {
+        LfuCache<int, int> cache(2);
+        int value = 0;
+        cache.put(1, 10);
+        cache.put(2, 20);
+        cache.get(1, value);
+        cache.get(1, value);
+        cache.get(2, value);
+        cache.put(3, 30);           // 2 has the lowest frequency
+        TestFramework::assert_test(
+            cache.contains(1) && !cache.contains(2) && cache.contains(3),
+            "LfuCache evicts least frequently used entry"
+        );
+        TestFramework::assert_test(
+            cache.frequency(1) == 3 && cache.frequency(3) == 1,
+            "LfuCache tracks access frequency"
+        );
+
+        cache.put(4, 40);           // tie on frequency 1: 3 is older
+        TestFramework::assert_test(
+            !cache.contains(3) && cache.contains(4) && cache.get_stats().evictions == 2,
+            "LfuCache breaks frequency ties by recency"
+        );
+    }
+
+    // Test sharded cache
+    {
+        ShardedCache<int, int> cache(64, 4);
+        for (int i = 0; i < 32; ++i)
+            cache.put(i, i * i);
+        int value = 0;
+        bool all_found = true;
+        for (int i = 0; i < 32; ++i)
+            all_found = all_found && cache.get(i, value) && value == i * i;
+        TestFramework::assert_test(
+            all_found && cache.size() == 32,
+            "ShardedCache stores and finds keys across shards"
+        );
+
+        ShardedCache<int, int, LfuCache> lfu(8, 2, false);
+        lfu.put(1, 1);
+        TestFramework::assert_test(
+            lfu.get(1, value) && lfu.get_stats().hits == 1,
+            "ShardedCache works unlocked with LfuCache engine"
+        );
+    }
+}
+
+//====================================================================================
+// TIERED LIST TESTS
+//====================================================================================
+
+void test_tiered_list_functions() {
+    cout << "\n=== TIERED LIST TESTS ===" << el;
+
+    // Test list-level split/append helpers
+    {
+        LinkedList list, rest;
+        TestHelper::populate_list(list, { 1, 2, 3, 4, 5 });
+        list.split_after(2, rest);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 1, 2 }) && TestHelper::verify_list_contents(rest, { 3, 4, 5 }),
+            "split_after moves the tail part to another list"
+        );
+        list.append(rest);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 1, 2, 3, 4, 5 }) && rest.get_length() == 0,
+            "append concatenates and empties the other list"
+        );
+        list.insert_at(3, 9);
+        list.delete_nth_node(1);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 2, 9, 3, 4, 5 }),
+            "insert_at and delete_nth_node work by position"
+        );
+    }
+
+    // Test positional operations against a vector model
+    {
+        TieredList list(4);
+        std::vector<int> model;
+        unsigned seed = 7;
+        auto next_rand = [&seed]() { seed = seed * 1103515245 + 12345; return (int)((seed >> 16) & 0x7fff); };
+
+        bool all_match = true;
+        for (int step = 0; step < 400; ++step) {
+            int op = next_rand() % 3;
+            if (op < 2 || model.empty()) {
+                int pos = next_rand() % ((int)model.size() + 1) + 1;
+                list.insert_at(pos, step);
+                model.insert(model.begin() + (pos - 1), step);
+            }
+            else {
+                int pos = next_rand() % (int)model.size() + 1;
+                list.delete_at(pos);
+                model.erase(model.begin() + (pos - 1));
+            }
+            list.debug_verify_data_integrity();
+        }
+        for (int i = 1; i <= (int)model.size(); ++i)
+            all_match = all_match && list.get_nth(i)->data == model[i - 1];
+
+        TestFramework::assert_test(
+            all_match && list.get_length() == (int)model.size(),
+            "TieredList matches vector model after random inserts/deletes"
+        );
+        TestFramework::assert_test(
+            list.get_block_count() <= 2 * (int)model.size() / 4 + 1,
+            "TieredList keeps block count at O(n / block_size)"
+        );
+        TestFramework::assert_test(
+            list.get_nth(0) == nullptr && list.get_nth(list.get_length() + 1) == nullptr,
+            "TieredList get_nth returns nullptr out of range"
+        );
+    }
+
+    // Test draining the list
+    {
+        TieredList list(2);
+        for (int i = 1; i <= 10; ++i)
+            list.insert_end(i);
+        list.insert_front(0);
+        TestFramework::assert_test(
+            list.debug_to_string() == "0 1 2 3 4 5 6 7 8 9 10",
+            "TieredList insert_front/insert_end keep order"
+        );
+        while (list.get_length())
+            list.delete_at(1);
+        list.debug_verify_data_integrity();
+        TestFramework::assert_test(
+            list.get_block_count() == 0 && list.debug_to_string().empty(),
+            "TieredList removes empty blocks"
+        );
+    }
+
+    // Test the default block size following sqrt(length)
+    {
+        TieredList list;
+        std::vector<int> model;
+        unsigned seed = 11;
+        auto next_rand = [&seed]() { seed = seed * 1103515245 + 12345; return (int)((seed >> 16) & 0x7fff); };
+
+        list.insert_end(-1);
+        model.push_back(-1);
+        Node* first = list.get_nth(1);
+
+        bool all_match = true, sqrt_blocks = true;
+        for (int step = 0; step < 3000; ++step) {
+            int pos = next_rand() % (int)model.size() + 2; // keep the first node in place
+            list.insert_at(pos, step);
+            model.insert(model.begin() + (pos - 1), step);
+            if (step % 100 == 0)
+                list.debug_verify_data_integrity();
+            sqrt_blocks = sqrt_blocks && list.get_block_count() <= 2 * list.get_length() / list.get_block_size() + 1;
+        }
+        list.debug_verify_data_integrity();
+        for (int i = 1; i <= (int)model.size(); ++i)
+            all_match = all_match && list.get_nth(i)->data == model[i - 1];
+        int grown_block_size = list.get_block_size();
+
+        TestFramework::assert_test(
+            all_match && list.get_nth(1) == first,
+            "Adaptive TieredList matches vector model and keeps nodes in place while re-blocking"
+        );
+        TestFramework::assert_test(
+            sqrt_blocks && grown_block_size * grown_block_size / 4 <= list.get_length() &&
+            list.get_length() <= 4 * grown_block_size * grown_block_size,
+            "Adaptive TieredList keeps block size and block count near sqrt(n)"
+        );
+
+        while (list.get_length() > 20) {
+            int pos = next_rand() % list.get_length() + 1;
+            list.delete_at(pos);
+            model.erase(model.begin() + (pos - 1));
+        }
+        list.debug_verify_data_integrity();
+        all_match = list.get_length() == (int)model.size();
+        for (int i = 1; i <= (int)model.size(); ++i)
+            all_match = all_match && list.get_nth(i)->data == model[i - 1];
+        TestFramework::assert_test(
+            all_match && list.get_block_size() < grown_block_size,
+            "Adaptive TieredList shrinks its blocks as the list shrinks"
+        );
+    }
+
+    // Test a large list keeps its blocks at about sqrt(n)
+    {
+        TieredList list;
+        const int n = 30000;
+        for (int i = 0; i < n; ++i)
+            list.insert_at(list.get_length() / 2 + 1, i);
+        int size = list.get_block_size();
+        TestFramework::assert_test(
+            size * size / 4 <= n && n <= 4 * size * size && list.get_block_count() <= 2 * n / size + 1 &&
+            list.get_nth(n / 2)->data == n - 1,
+            "Adaptive TieredList needs O(sqrt(n)) blocks and block steps after 30000 middle inserts"
+        );
+    }
+}
+
+//====================================================================================
+// INTRUSIVE LIST TESTS
+//====================================================================================
+
+struct PooledTask {
+    int id{};
+    ListHook all_hook;      // membership in the "all tasks" list
+    ListHook ready_hook;    // membership in the "ready" list
+    PooledTask(int id = 0) :id(id) {}
+};
+
+typedef IntrusiveList<PooledTask, &PooledTask::all_hook> AllTasks;
+typedef IntrusiveList<PooledTask, &PooledTask::ready_hook> ReadyTasks;
+
+static std::string intrusive_to_string(AllTasks& list) {
+    std::string ret;
+    for (PooledTask& task : list)
+        ret += (ret.empty() ? "" : " ") + std::to_string(task.id);
+    return ret;
+}
+
+void test_intrusive_list_functions() {
+    cout << "\n=== INTRUSIVE LIST TESTS ===" << el;
+
+    PooledTask pool[5] = { 1, 2, 3, 4, 5 };
+
+    // Test linking existing objects
+    {
+        AllTasks all;
+        for (PooledTask& task : pool)
+            all.insert_end(task);
+        TestFramework::assert_test(
+            intrusive_to_string(all) == "1 2 3 4 5" && all.size() == 5,
+            "IntrusiveList links pooled objects in order"
+        );
+
+        all.erase(pool[2]);
+        all.insert_front(pool[2]);              // 3 1 2 4 5
+        PooledTask* last = all.delete_end();    // 3 1 2 4
+        all.insert_before(pool[3], *last);      // 3 1 2 5 4
+        all.erase(pool[1]);
+        all.insert_after(pool[0], pool[1]);     // 3 1 2 5 4
+        TestFramework::assert_test(
+            intrusive_to_string(all) == "3 1 2 5 4" && all.front()->id == 3 && all.back()->id == 4,
+            "IntrusiveList erase/insert_before/insert_after relink in place"
+        );
+        TestFramework::assert_test(
+            all.next(pool[0])->id == 2 && all.prev(pool[2]) == nullptr,
+            "IntrusiveList next/prev navigate between objects"
+        );
+    }
+    // List destroyed: every hook is unlinked again
+    bool all_unlinked = true;
+    for (PooledTask& task : pool)
+        all_unlinked = all_unlinked && !task.all_hook.is_linked();
+    TestFramework::assert_test(all_unlinked, "IntrusiveList destructor unlinks all objects");
+
+    // Test membership in two lists and auto-unlink
+    {
+        AllTasks all;
+        ReadyTasks ready;
+        for (PooledTask& task : pool)
+            all.insert_end(task);
+        ready.insert_end(pool[1]);
+        ready.insert_end(pool[3]);
+        {
+            PooledTask temp(9);
+            all.insert_end(temp);
+            ready.insert_front(temp);
+            TestFramework::assert_test(
+                all.size() == 6 && ready.size() == 3,
+                "Object can be in two lists at once"
+            );
+        }   // temp destroyed here
+        TestFramework::assert_test(
+            all.size() == 5 && ready.size() == 2 && ready.front()->id == 2,
+            "Destroyed object auto-unlinks from every list"
+        );
+        ready.delete_front();
+        TestFramework::assert_test(
+            ready.size() == 1 && all.size() == 5 && pool[1].all_hook.is_linked(),
+            "Removing from one list keeps other memberships"
+        );
+    }
+}
+
+//====================================================================================
+// MEMORY LAYOUT TESTS
+//====================================================================================
+
+void test_compact_functions() {
+    cout << "\n=== MEMORY LAYOUT TESTS ===" << el;
+
+    // Test compaction of a scattered list
+    {
+        LinkedList list;
+        for (int i = 0; i < 50; ++i)
+            list.insert_sorted((i * 37) % 50);
+        for (int i = 0; i < 50; i += 7)
+            list.delete_node_with_key(i);
+        list.swap_kth(3);
+        string before = list.debug_to_string();
+
+        TestFramework::assert_test(
+            list.fragmentation() > 0.5,
+            "fragmentation detects scattered nodes"
+        );
+        TestFramework::assert_test(
+            list.compact_if_fragmented(0.5),
+            "compact_if_fragmented compacts above threshold"
+        );
+        TestFramework::assert_test(
+            list.fragmentation() == 0.0 && list.debug_to_string() == before,
+            "compact lays nodes out in list order and keeps values"
+        );
+        TestFramework::assert_test(
+            !list.compact_if_fragmented(0.5),
+            "compact_if_fragmented skips compact lists"
+        );
+
+        // Keep working on compacted nodes
+        list.delete_front();
+        list.delete_end();
+        list.delete_node_with_key(list.get_nth_node(5)->data);
+        list.insert_front(-1);
+        list.reverse();
+        list.debug_verfiy_data_integrity();
+        list.compact();
+        TestFramework::assert_test(
+            list.fragmentation() == 0.0 && list.get_nth_node_back(1)->data == -1,
+            "compacted list supports further insert/delete/compact"
+        );
+    }
+
+    // Test moving compacted nodes between lists
+    {
+        LinkedList list1, list2;
+        TestHelper::populate_list(list1, { 1, 3, 5, 7 });
+        TestHelper::populate_list(list2, { 2, 4, 6 });
+        list1.compact();
+        list2.compact();
+        list1.merge_2sorted_lists(list2);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list1, { 1, 2, 3, 4, 5, 6, 7 }),
+            "merge_2sorted_lists works with compacted lists"
+        );
+
+        LinkedList rest;
+        list1.split_after(3, rest);
+        list1.compact();    // rest still uses the old block
+        rest.delete_front();
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list1, { 1, 2, 3 }) && TestHelper::verify_list_contents(rest, { 5, 6, 7 }),
+            "split_after keeps compacted storage alive for both lists"
+        );
+    }
+
+    // Test huge page and NUMA backed slabs (each falls back when unavailable)
+    {
+        NodeMemoryResource::Options saved = NodeMemoryResource::options();
+        bool ok = true;
+        for (HugePages policy : { HugePages::transparent, HugePages::explicit_pages }) {
+            NodeMemoryResource::options().huge_pages = policy;
+            NodeMemoryResource::options().bind_to_local_node = true;
+
+            Slab slab = NodeMemoryResource::allocate(3 * NodeMemoryResource::huge_page_size);
+            char* bytes = static_cast<char*>(slab.memory);
+            bytes[0] = 1;
+            bytes[slab.bytes - 1] = 2;
+            ok = ok && bytes && slab.mapped_bytes >= slab.bytes;
+            if (slab.huge_pages && policy == HugePages::transparent)
+                ok = ok && (std::size_t)bytes % NodeMemoryResource::huge_page_size == 0;
+            NodeMemoryResource::deallocate(slab);
+        }
+        TestFramework::assert_test(ok, "NodeMemoryResource maps huge page and NUMA slabs with fallback");
+
+        LinkedList list;
+        for (int i = 0; i < 100000; ++i)
+            list.insert_front(i);
+        list.compact();
+        list.delete_front();
+        list.debug_verfiy_data_integrity();
+        TestFramework::assert_test(
+            list.fragmentation() == 0.0 && list.get_nth_node(1)->data == 99998 && list.get_nth_node_back(1)->data == 0,
+            "compact works on huge page backed blocks"
+        );
+        NodeMemoryResource::options() = saved;
+    }
+
+    // Test the per-list arena every node comes from
+    {
+        NodeArena<Node> arena(4);
+        Node* first = arena.create(1);
+        arena.create(2);
+        arena.destroy(first);
+        Node* reused = arena.create(3);
+        TestFramework::assert_test(
+            reused == first && reused->data == 3 && arena.block_count() == 1,
+            "NodeArena reuses freed slots before taking new memory"
+        );
+
+        for (int i = 0; i < 100; ++i)
+            arena.create(i);
+        NodeArena<Node> other;
+        other.adopt(arena);
+        arena.reset();
+        TestFramework::assert_test(
+            arena.block_count() == 0 && other.block_count() == 5 && other.contains(reused) && reused->data == 3,
+            "NodeArena blocks double in size and stay alive in the arena that adopted them"
+        );
+        other.reset();
+
+        // Without compact(), a list built in order is already laid out in order
+        NodeMemoryResource::Options saved = NodeMemoryResource::options();
+        NodeMemoryResource::options().huge_pages = HugePages::transparent;
+        LinkedList list;
+        for (int i = 0; i < 300000; ++i)
+            list.insert_end(i);
+        NodeMemoryResource::options() = saved;
+        TestFramework::assert_test(
+            list.fragmentation() < 0.001 && list.get_nth_node(150000)->data == 149999,
+            "insert_end fills huge page sized arena blocks in list order"
+        );
+    }
+}
+
+//====================================================================================
+// HANDLE TESTS
+//====================================================================================
+
+void test_handle_functions() {
+    cout << "\n=== HANDLE TESTS ===" << el;
+
+    // Test O(1) erase and insert around handles
+    {
+        LinkedList list;
+        NodeHandle h1 = list.insert_end(1);
+        NodeHandle h3 = list.insert_end(3);
+        NodeHandle h5 = list.insert_end(5);
+        list.insert_after(h1, 2);
+        list.insert_before(h5, 4);
+        list.insert_before(h1, 0);
+        list.insert_after(h5, 6);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 0, 1, 2, 3, 4, 5, 6 }),
+            "insert_before/insert_after place values around a handle"
+        );
+
+        TestFramework::assert_test(
+            list.erase(h3) && TestHelper::verify_list_contents(list, { 0, 1, 2, 4, 5, 6 }),
+            "erase removes the node referenced by a handle"
+        );
+        TestFramework::assert_test(
+            !list.is_valid(h3) && !list.erase(h3) && !list.is_valid(list.insert_after(h3, 9)),
+            "stale handle is detected after erase"
+        );
+
+        // The freed slot is reused; the old handle must stay stale
+        NodeHandle reused = list.insert_front(-1);
+        TestFramework::assert_test(
+            reused.node == h3.node && !list.is_valid(h3) && list.resolve(reused)->data == -1,
+            "reused slot does not revive an old handle"
+        );
+
+        TestFramework::assert_test(
+            list.erase(list.handle_of(list.get_nth_node(1))) && list.erase(list.insert_sorted(3)),
+            "handle_of and insert_sorted return usable handles"
+        );
+    }
+
+    // Test handles across relinking and relocation
+    {
+        LinkedList list;
+        vector<NodeHandle> handles;
+        for (int i = 1; i <= 6; ++i)
+            handles.push_back(list.insert_front(i));
+        list.reverse();
+        list.swap_kth(2);
+        TestFramework::assert_test(
+            list.resolve(handles[0])->data == 1 && list.resolve(handles[5])->data == 6,
+            "handles survive reverse and swap"
+        );
+
+        // compact() moves every node, like it invalidates Node pointers
+        list.compact();
+        bool all_stale = true;
+        for (NodeHandle handle : handles)
+            all_stale = all_stale && !list.is_valid(handle);
+        for (int i = 1; i <= list.get_length(); ++i)
+            handles[list.get_nth_node(i)->data - 1] = list.handle_of(list.get_nth_node(i));
+        TestFramework::assert_test(
+            all_stale && list.resolve(handles[0])->data == 1 && list.resolve(handles[5])->data == 6,
+            "compact makes handles stale and handle_of issues new ones"
+        );
+
+        list.erase(handles[1]);
+        list.delete_all_nodes_with_key(4);
+        list.delete_front();
+        TestFramework::assert_test(
+            !list.is_valid(handles[1]) && !list.is_valid(handles[3]) && !list.is_valid(handles[0]),
+            "handles become stale for every kind of deletion"
+        );
+
+        LinkedList rest;
+        list.split_after(1, rest);
+        TestFramework::assert_test(
+            list.is_valid(handles[4]) && !list.is_valid(handles[2]) && !rest.is_valid(handles[2]),
+            "handles of nodes moved to another list become stale"
+        );
+
+        list.erase(handles[4]);
+        TestFramework::assert_test(
+            TestHelper::verify_empty_list(list) && TestHelper::verify_list_contents(rest, { 3, 6 }),
+            "erase can empty the list through handles"
+        );
+    }
+
+    // Test that erase and insert through handles do not depend on the length
+    {
+        const int n = 100000;
+        LinkedList list;
+        vector<NodeHandle> handles;
+        for (int i = 0; i < n; ++i)
+            handles.push_back(list.insert_end(i));
+
+        // A linear step per call would be n * n / 2 = 5e9 steps here
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 1; i < n; i += 2) {
+            list.insert_after(handles[i], -i);
+            list.erase(handles[i]);
+        }
+        list.insert_before(handles[n / 2], -1);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        TestFramework::assert_test(
+            seconds < 2.0 && list.get_length() == n + 1 && list.get_nth_node(2)->data == -1,
+            "erase/insert_after over 100000 handles stay O(1) per call"
+        );
+        list.debug_verfiy_data_integrity();
+    }
+}
+
+//====================================================================================
+// CONCURRENT DEQUE TESTS
+//====================================================================================
+
+void test_concurrent_deque_functions() {
+    cout << "\n=== CONCURRENT DEQUE TESTS ===" << el;
+
+    // Test single-threaded deque order at both ends
+    {
+        ConcurrentDeque<int> deque;
+        int value = 0;
+        TestFramework::assert_test(
+            !deque.try_pop_front(value) && !deque.try_pop_back(value),
+            "try_pop on an empty deque fails"
+        );
+
+        for (int i = 1; i <= 10; ++i)
+            deque.push_back(i);
+        deque.push_front(0);
+        bool ok = deque.size() == 11;
+        ok = ok && deque.try_pop_front(value) && value == 0;
+        ok = ok && deque.try_pop_back(value) && value == 10;
+        ok = ok && deque.try_pop_front(value) && value == 1;
+        TestFramework::assert_test(ok && deque.size() == 8, "push/pop keep deque order at both ends");
+    }
+
+    // Test producers at the back and consumers at the front
+    {
+        ConcurrentDeque<int> deque;
+        const int producers = 4, per_producer = 20000;
+        std::atomic<long long> consumed_sum{ 0 };
+        std::atomic<int> consumed_count{ 0 };
+
+        vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back([&deque, p]() {
+                for (int i = 1; i <= per_producer; ++i)
+                    if (i % 2)
+                        deque.push_back(i);
+                    else
+                        deque.push_front(i);
+            });
+        for (int c = 0; c < 4; ++c)
+            threads.emplace_back([&deque, &consumed_sum, &consumed_count, c]() {
+                int value;
+                while (c % 2 ? deque.pop_back(value) : deque.pop_front(value)) {
+                    consumed_sum += value;
+                    ++consumed_count;
+                }
+            });
+
+        for (int p = 0; p < producers; ++p)
+            threads[p].join();
+        // Let the consumers drain the deque, then release them
+        while (!deque.is_empty())
+            std::this_thread::yield();
+        deque.close();
+        for (int c = producers; c < (int)threads.size(); ++c)
+            threads[c].join();
+
+        long long expected = (long long)producers * per_producer * (per_producer + 1) / 2;
+        TestFramework::assert_test(
+            consumed_count == producers * per_producer && consumed_sum == expected,
+            "concurrent pushes and pops lose and duplicate nothing"
+        );
+    }
+
+    // Test blocking pop wakes on push and on close
+    {
+        ConcurrentDeque<std::string> deque;
+        std::string got;
+        std::thread consumer([&deque, &got]() { deque.pop_back(got); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        deque.push_front("work");
+        consumer.join();
+
+        bool after_close = true;
+        std::thread waiter([&deque, &after_close]() {
+            std::string value;
+            after_close = deque.pop_front(value);
+        });
+        deque.close();
+        waiter.join();
+        TestFramework::assert_test(
+            got == "work" && !after_close,
+            "blocking pop wakes on push and returns false after close"
+        );
+    }
+}
+
+//====================================================================================
+// RCU LIST TESTS
+//====================================================================================
+
+void test_rcu_list_functions() {
+    cout << "\n=== RCU LIST TESTS ===" << el;
+
+    // Test writer operations and reader queries without concurrency
+    {
+        RcuLinkedList list(2);
+        for (int x : { 3, 1, 2, 5, 4 })
+            list.insert_sorted(x);
+        list.insert_front(0);
+        list.insert_end(9);
+        list.debug_verify_data_integrity();
+        TestFramework::assert_test(
+            list.debug_to_string() == "0 1 2 3 4 5 9" && list.get_length() == 7,
+            "RcuLinkedList insertions keep order"
+        );
+
+        int value = -1, middle = -1;
+        bool ok = list.search(4) && !list.search(7);
+        ok = ok && list.get_nth(4, value) && value == 3 && !list.get_nth(8, value);
+        ok = ok && list.find_the_middle(middle) && middle == 3;
+        TestFramework::assert_test(ok, "RcuLinkedList search, get_nth and find_the_middle");
+
+        list.delete_front();
+        list.delete_end();
+        bool deleted = list.delete_node_with_key(3) && !list.delete_node_with_key(3);
+        list.debug_verify_data_integrity();
+        TestFramework::assert_test(
+            deleted && list.debug_to_string() == "1 2 4 5" && list.get_pending_reclaim() == 1,
+            "RcuLinkedList deletions retire nodes in batches"
+        );
+
+        list.synchronize();
+        list.delete_node_with_key(4);
+        list.delete_node_with_key(5);
+        list.insert_end(2);
+        list.insert_end(1);
+        TestFramework::assert_test(
+            list.get_pending_reclaim() == 0 && list.is_palindrome() && list.to_vector() == vector<int>({ 1, 2, 2, 1 }),
+            "RcuLinkedList synchronize reclaims and is_palindrome works"
+        );
+    }
+
+    // Test lock-free readers while a writer keeps unlinking nodes
+    {
+        RcuLinkedList list(8);
+        for (int i = 0; i < 64; ++i)
+            list.insert_end(i);
+
+        std::atomic<bool> done{ false };
+        std::atomic<long long> reads{ 0 };
+        std::atomic<int> bad_reads{ 0 };
+        vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r)
+            readers.emplace_back([&list, &done, &reads, &bad_reads]() {
+                while (!done) {
+                    int value = -1;
+                    // Values are always inserted in increasing order
+                    int last = -1;
+                    bool sorted = true;
+                    list.for_each([&last, &sorted](int v) { sorted = sorted && v > last; last = v; });
+                    if (!sorted || (list.get_nth(1, value) && value < 0))
+                        ++bad_reads;
+                    list.find_the_middle(value);
+                    ++reads;
+                }
+            });
+
+        // Do not let the writer finish before the readers got going
+        while (reads == 0)
+            std::this_thread::yield();
+        // Every 8 deletions wait for a grace period, so keep the rounds modest
+        const int writes = 2000;
+        for (int i = 64; i < 64 + writes; ++i) {
+            list.insert_end(i);
+            list.delete_front();
+        }
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+        list.synchronize();
+        list.debug_verify_data_integrity();
+
+        int first = -1;
+        TestFramework::assert_test(
+            bad_reads == 0 && reads > 0 && list.get_length() == 64 && list.get_nth(1, first) && first == writes,
+            "RcuLinkedList readers stay consistent during concurrent writes"
+        );
+        TestFramework::assert_test(list.get_pending_reclaim() == 0, "RcuLinkedList reclaims every retired node");
+    }
+}
+
+void test_small_list_functions() {
+    cout << "\n=== SMALL LIST TESTS ===" << el;
+
+    // A node is inline when its address lies inside the list object
+    auto is_inline = [](const auto& list, const Node* node) {
+        const char* begin = reinterpret_cast<const char*>(&list);
+        const char* address = reinterpret_cast<const char*>(node);
+        return begin <= address && address < begin + sizeof(list);
+    };
+
+    // Test the first N nodes stay inline and the rest spill to the heap
+    {
+        SmallLinkedList<4> list;
+        TestHelper::populate_list(list, { 1, 2, 3, 4 });
+        bool all_inline = true;
+        for (int i = 1; i <= 4; ++i)
+            all_inline = all_inline && is_inline(list, list.get_nth_node(i));
+        TestFramework::assert_test(all_inline, "SmallLinkedList keeps the first N nodes inline");
+
+        list.insert_end(5);
+        list.insert_front(0);
+        list.debug_verfiy_data_integrity();
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 0, 1, 2, 3, 4, 5 }) &&
+            !is_inline(list, list.get_nth_node(1)) && !is_inline(list, list.get_nth_node(6)),
+            "SmallLinkedList spills extra nodes to the heap"
+        );
+
+        list.delete_node_with_key(2);
+        list.insert_sorted(2);
+        TestFramework::assert_test(
+            TestHelper::verify_list_contents(list, { 0, 1, 2, 3, 4, 5 }) && is_inline(list, list.get_nth_node(3)),
+            "SmallLinkedList reuses freed inline slots"
+        );
+
+        list.erase_if([](int x) { return x % 2 == 0; });
+        list.insert_end(7);
+        list.debug_verfiy_data_integrity();
+        TestFramework::assert_test(TestHelper::verify_list_contents(list, { 1, 3, 5, 7 }), "SmallLinkedList erase_if and reinsert");
+    }
+
+    // Test nodes handed to other lists leave the inline slots first
+    {
+        LinkedList plain;
+        {
+            SmallLinkedList<4> small;
+            TestHelper::populate_list(small, { 1, 3 });
+            NodeHandle handle = small.insert_end(5);
+            small.split_after(1, plain);
+            TestFramework::assert_test(
+                !small.is_valid(handle) && !is_inline(small, plain.get_nth_node(1)) &&
+                is_inline(small, small.get_nth_node(1)),
+                "SmallLinkedList split_after moves nodes out of inline storage"
+            );
+
+            SmallLinkedList<4> other;
+            TestHelper::populate_list(other, { 2, 4 });
+            small.merge_2sorted_lists(other);
+            plain.append(small);
+        }
+        // The small lists are gone: plain must only hold heap nodes
+        plain.debug_verfiy_data_integrity();
+        TestFramework::assert_test(TestHelper::verify_list_contents(plain, { 3, 5, 1, 2, 4 }), "SmallLinkedList nodes survive the list");
+    }
+
+    // Test compact() moves nodes out of the inline slots
+    {
+        SmallLinkedList<2> list;
+        NodeHandle first = list.insert_end(1);
+        list.insert_end(2);
+        list.insert_end(3);
+        list.compact();
+        NodeHandle moved = list.handle_of(list.get_nth_node(1));
+        TestFramework::assert_test(
+            !list.is_valid(first) && list.resolve(moved)->data == 1 && !is_inline(list, list.resolve(moved)) &&
+            TestHelper::verify_list_contents(list, { 1, 2, 3 }),
+            "SmallLinkedList compact relocates inline nodes"
+        );
+        list.insert_front(0);
+        TestFramework::assert_test(is_inline(list, list.get_nth_node(1)), "SmallLinkedList reuses slots after compact");
+
+        // Inline slots carry a generation too: a reused slot does not revive a handle
+        NodeHandle inline_handle = list.insert_front(-1);
+        list.erase(inline_handle);
+        NodeHandle reused = list.insert_front(-2);
+        TestFramework::assert_test(
+            reused.node == inline_handle.node && !list.is_valid(inline_handle) && list.resolve(reused)->data == -2,
+            "SmallLinkedList handles to reused inline slots stay stale"
+        );
+    }
+}
+
+void test_streaming_functions() {
+    cout << "\n=== STREAMING TESTS ===" << el;
+#ifdef DS_HAS_COROUTINES
+    LinkedList list;
+    TestHelper::populate_list(list, { 1, 2, 3, 4, 5, 6 });
+
+    vector<int> forward, backward;
+    for (int value : list.values())
+        forward.push_back(value);
+    for (int value : list.reverse_values())
+        backward.push_back(value);
+    TestFramework::assert_test(
+        forward == vector<int>({ 1, 2, 3, 4, 5, 6 }) && backward == vector<int>({ 6, 5, 4, 3, 2, 1 }),
+        "values and reverse_values stream the list"
+    );
+
+    vector<vector<int>> batches;
+    for (const vector<int>& batch : list.reverse_values()
+            | pipeline::filter([](int x) { return x != 4; })
+            | pipeline::map([](int x) { return x * 10; })
+            | pipeline::take(4)
+            | pipeline::chunk(3))
+        batches.push_back(batch);
+    TestFramework::assert_test(
+        batches == vector<vector<int>>({ { 60, 50, 30 }, { 20 } }),
+        "Pipeline stages filter, map, take and chunk lazily"
+    );
+
+    // nodes() reads ahead, so the current node may be deleted
+    for (Node* node : list.nodes())
+        if (node->data % 2 == 0)
+            list.delete_node_with_key(node->data);
+    TestFramework::assert_test(TestHelper::verify_list_contents(list, { 1, 3, 5 }), "nodes allows deleting the current node");
+
+    // Exceptions thrown inside a stage reach the consumer
+    bool caught = false;
+    try {
+        for (int value : list.values() | pipeline::map([](int x) { if (x == 3) throw std::runtime_error("stop"); return x; }))
+            (void)value;
+    }
+    catch (const std::runtime_error&) {
+        caught = true;
+    }
+    TestFramework::assert_test(caught, "Pipeline forwards exceptions to the consumer");
+#else
+    cout << "Streaming needs C++20 coroutines (skipped)" << el;
+#endif
+}
+
+void test_order_statistic_functions() {
+    cout << "\n=== ORDER STATISTIC TESTS ===" << el;
+
+    // Test queries on a small list with duplicates
+    {
+        OrderStatisticList list;
+        for (int x : { 50, 10, 40, 20, 30, 20, 60 })
+            list.insert(x);
+        list.debug_verify_data_integrity();
+        TestFramework::assert_test(
+            list.debug_to_string() == "10 20 20 30 40 50 60" && list.get_length() == 7,
+            "OrderStatisticList insert keeps values sorted"
+        );
+        TestFramework::assert_test(
+            list.select(1) == 10 && list.select(3) == 20 && list.select(7) == 60 && list.median() == 30,
+            "OrderStatisticList select and median"
+        );
+        TestFramework::assert_test(
+            list.rank(20) == 1 && list.rank(25) == 3 && list.rank(5) == 0 && list.rank(99) == 7,
+            "OrderStatisticList rank counts smaller values"
+        );
+        TestFramework::assert_test(
+            list.count_range(20, 40) == 4 && list.count_range(21, 29) == 0 && list.count_range(40, 20) == 0 &&
+            list.count_range(0, 100) == 7,
+            "OrderStatisticList count_range is inclusive"
+        );
+        TestFramework::assert_test(
+            list.percentile(50) == 30 && list.percentile(100) == 60 && list.percentile(1) == 10 &&
+            list.min() == 10 && list.max() == 60,
+            "OrderStatisticList percentile, min and max"
+        );
+
+        bool erased = list.erase(20) && list.erase(60) && !list.erase(35);
+        list.debug_verify_data_integrity();
+        TestFramework::assert_test(
+            erased && list.debug_to_string() == "10 20 30 40 50" && list.contains(20) && !list.contains(60) &&
+            list.median() == 30 && list.max() == 50,
+            "OrderStatisticList erase removes one occurrence"
+        );
+
+        list.erase(40);
+        TestFramework::assert_test(list.median() == 25.0, "OrderStatisticList median of even length");
+    }
+
+    // Test against a sorted vector under random inserts and erases
+    {
+        OrderStatisticList list(42);
+        vector<int> reference;
+        std::mt19937 rng(7);
+        bool ok = true;
+        for (int step = 0; step < 4000 && ok; ++step) {
+            int val = (int)(rng() % 500);
+            if (rng() % 3 == 0) {
+                auto it = std::lower_bound(reference.begin(), reference.end(), val);
+                bool found = it != reference.end() && *it == val;
+                if (found)
+                    reference.erase(it);
+                ok = list.erase(val) == found;
+            }
+            else {
+                reference.insert(std::upper_bound(reference.begin(), reference.end(), val), val);
+                list.insert(val);
+            }
+            if (step % 97 == 0 && !reference.empty()) {
+                int k = 1 + (int)(rng() % reference.size());
+                int lo = (int)(rng() % 500), hi = lo + (int)(rng() % 100);
+                int in_range = (int)(std::upper_bound(reference.begin(), reference.end(), hi) -
+                    std::lower_bound(reference.begin(), reference.end(), lo));
+                ok = ok && list.select(k) == reference[k - 1] &&
+                    list.rank(val) == std::lower_bound(reference.begin(), reference.end(), val) - reference.begin() &&
+                    list.count_range(lo, hi) == in_range;
+            }
+        }
+        list.debug_verify_data_integrity();
+        TestFramework::assert_test(ok && list.get_length() == (int)reference.size(), "OrderStatisticList matches a sorted vector");
+    }
+}
+
+void test_statistics_functions() {
+    cout << "\n=== STATISTICS TESTS ===" << el;
+#ifdef DS_ENABLE_STATS
+    // Test memory counters follow allocations, frees and moved nodes
+    {
+        LinkedList list, other;
+        TestHelper::populate_list(list, { 1, 2, 3, 4 });
+        TestHelper::populate_list(other, { 5, 6 });
+        list.delete_front();
+        ContainerStats stats = list.get_stats();
+        TestFramework::assert_test(
+            stats.live_nodes == 3 && stats.allocations == 4 && stats.frees == 1 &&
+            stats.bytes == 3 * (long long)sizeof(Node) && stats.peak_bytes == 4 * (long long)sizeof(Node),
+            "Stats count allocations and frees"
+        );
+
+        list.append(other);
+        TestFramework::assert_test(
+            list.get_stats().live_nodes == 5 && other.get_stats().live_nodes == 0 && other.get_stats().bytes == 0,
+            "Stats move nodes with append"
+        );
+    }
+
+    // Test per-operation calls and traversed nodes, and the JSON export
+    {
+        LinkedList list;
+        TestHelper::populate_list(list, { 1, 2, 3, 4, 5 });
+        list.get_nth_node(3);
+        list.get_nth_node(4);
+        ContainerStats stats = list.get_stats();
+        OperationStats get_nth = stats.operation("get_nth_node");
+        TestFramework::assert_test(
+            stats.operation("insert_end").calls == 5 && get_nth.calls == 2 && get_nth.nodes_traversed > 0,
+            "Stats count operation calls and traversed nodes"
+        );
+        TestFramework::assert_test(stats.operation("reverse").calls == 0, "Stats report zeros for unused operations");
+
+        string json = stats.to_json();
+        TestFramework::assert_test(
+            json.find("\"live_nodes\":5") != string::npos && json.find("\"get_nth_node\":{\"calls\":2") != string::npos,
+            "Stats export as JSON"
+        );
+    }
+#else
+    cout << "Statistics are disabled (build with DS_ENABLE_STATS to run these tests)" << el;
+#endif
+}
+
 //====================================================================================
 // MAIN TEST RUNNER
 //====================================================================================
@@ -643,6 +1853,17 @@ int main() {FAST;
     test_access_functions();
     test_manipulation_functions();
     test_edge_cases();
+    test_cache_functions();
+    test_tiered_list_functions();
+    test_intrusive_list_functions();
+    test_compact_functions();
+    test_handle_functions();
+    test_concurrent_deque_functions();
+    test_rcu_list_functions();
+    test_small_list_functions();
+    test_streaming_functions();
+    test_order_statistic_functions();
+    test_statistics_functions();
 
     // Print final summary
     TestFramework::print_summary();
@@ -0,0 +1,274 @@
+#include "TieredList.h"
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#define el '\n'
+
+using std::cout;
+
+//====================================================================================
+// CONSTRUCTORS AND DESTRUCTOR
+//====================================================================================
+
+const int TieredList::min_block_size;
+
+TieredList::TieredList(int block_size)
+	:block_size(block_size ? block_size : min_block_size), adaptive(block_size == 0) {
+	assert(block_size >= 0);
+}
+
+TieredList::~TieredList() {
+	// Each block's LinkedList destructor deletes its nodes
+	while (head) {
+		Block* next = head->next;
+		delete head;
+		head = next;
+	}
+	tail = nullptr;
+	length = block_count = 0;
+}
+
+//====================================================================================
+// BLOCK MANAGEMENT
+//====================================================================================
+
+void TieredList::link(Block* first, Block* second) {
+	if (first)
+		first->next = second;
+	if (second)
+		second->prev = first;
+}
+
+TieredList::Block* TieredList::embed_block_after(Block* node_before) {
+	Block* item = new Block();
+	++block_count;
+
+	Block* node_after = node_before ? node_before->next : head;
+	link(node_before, item);
+	link(item, node_after);
+
+	if (!node_before)
+		head = item;
+	if (!node_after)
+		tail = item;
+	return item;
+}
+
+void TieredList::delete_block(Block* block) {
+	if (block == head)
+		head = block->next;
+	if (block == tail)
+		tail = block->prev;
+	link(block->prev, block->next);
+	--block_count;
+	delete block;
+}
+
+TieredList::Block* TieredList::find_block(int& n) {
+	// Skip whole blocks from the closer end of the list
+	if (n - 1 <= length - n) {
+		Block* cur = head;
+		while (n > cur->items.get_length()) {
+			n -= cur->items.get_length();
+			cur = cur->next;
+		}
+		return cur;
+	}
+
+	int from_back = length - n + 1;
+	Block* cur = tail;
+	while (from_back > cur->items.get_length()) {
+		from_back -= cur->items.get_length();
+		cur = cur->prev;
+	}
+	n = cur->items.get_length() - from_back + 1;
+	return cur;
+}
+
+void TieredList::split_if_full(Block* block) {
+	int block_length = block->items.get_length();
+	if (block_length <= 2 * block_size)
+		return;
+
+	Block* second_half = embed_block_after(block);
+	block->items.split_after(block_length / 2, second_half->items);
+}
+
+void TieredList::merge_if_sparse(Block* block) {
+	if (block->items.get_length() == 0) {
+		delete_block(block);
+		return;
+	}
+
+	// Pull the next block in while both fit in one block
+	Block* next = block->next;
+	if (next && block->items.get_length() + next->items.get_length() <= block_size) {
+		block->items.append(next->items);
+		delete_block(next);
+	}
+
+	Block* prev = block->prev;
+	if (prev && prev->items.get_length() + block->items.get_length() <= block_size) {
+		prev->items.append(block->items);
+		delete_block(block);
+	}
+}
+
+void TieredList::rebalance_if_needed() {
+	if (!adaptive)
+		return;
+	long long square = (long long)block_size * block_size;
+	if (length > 4 * square || (block_size > min_block_size && 4LL * length < square))
+		reblock(std::max(min_block_size, (int)std::lround(std::sqrt((double)length))));
+}
+
+void TieredList::reblock(int new_block_size) {
+	block_size = new_block_size;
+
+	// Detach the old blocks and refill a new chain from them in order
+	Block* old = head;
+	head = tail = nullptr;
+	block_count = 0;
+
+	while (old) {
+		Block* next_old = old->next;
+		while (old->items.get_length()) {
+			if (!tail || tail->items.get_length() == block_size)
+				embed_block_after(tail);
+			int room = block_size - tail->items.get_length();
+			if (old->items.get_length() <= room) {
+				tail->items.append(old->items);
+				break;
+			}
+			// Move the first room nodes and keep the rest in the old block
+			LinkedList rest;
+			old->items.split_after(room, rest);
+			tail->items.append(old->items);
+			old->items.append(rest);
+		}
+		delete old;
+		old = next_old;
+	}
+}
+
+//====================================================================================
+// ACCESS FUNCTIONS
+//====================================================================================
+
+int TieredList::get_length() const {
+	return length;
+}
+
+int TieredList::get_block_count() const {
+	return block_count;
+}
+
+int TieredList::get_block_size() const {
+	return block_size;
+}
+
+Node* TieredList::get_nth(int n) {
+	if (n <= 0 || n > length)
+		return nullptr;
+	Block* block = find_block(n);
+	return block->items.get_nth_node(n);
+}
+
+//====================================================================================
+// INSERTION AND DELETION FUNCTIONS
+//====================================================================================
+
+void TieredList::insert_at(int n, int val) {
+	if (n <= 0 || n > length + 1)
+		return;
+
+	Block* block;
+	if (!head) {
+		block = embed_block_after(nullptr);
+		n = 1;
+	}
+	else if (n == length + 1) {
+		// Appending: the position right after the last node of the tail block
+		block = tail;
+		n = tail->items.get_length() + 1;
+	}
+	else
+		block = find_block(n);
+
+	block->items.insert_at(n, val);
+	++length;
+	split_if_full(block);
+	rebalance_if_needed();
+}
+
+void TieredList::delete_at(int n) {
+	if (n <= 0 || n > length)
+		return;
+
+	Block* block = find_block(n);
+	block->items.delete_nth_node(n);
+	--length;
+	merge_if_sparse(block);
+	rebalance_if_needed();
+}
+
+void TieredList::insert_front(int val) {
+	insert_at(1, val);
+}
+
+void TieredList::insert_end(int val) {
+	insert_at(length + 1, val);
+}
+
+//====================================================================================
+// DISPLAY AND DEBUG FUNCTIONS
+//====================================================================================
+
+void TieredList::print() {
+	for (Block* block = head; block; block = block->next)
+		for (int i = 1; i <= block->items.get_length(); ++i)
+			cout << block->items.get_nth_node(i)->data << " ";
+	cout << el;
+}
+
+string TieredList::debug_to_string() {
+	std::ostringstream oss;
+	for (Block* block = head; block; block = block->next) {
+		string part = block->items.debug_to_string();
+		if (part.empty())
+			continue;
+		if (oss.tellp() > 0)
+			oss << " ";
+		oss << part;
+	}
+	return oss.str();
+}
+
+void TieredList::debug_verify_data_integrity() {
+	if (!head) {
+		assert(!tail);
+		assert(length == 0 && block_count == 0);
+		return;
+	}
+	assert(!head->prev && !tail->next);
+
+	int total = 0, blocks = 0;
+	for (Block* block = head; block; block = block->next, ++blocks) {
+		int block_length = block->items.get_length();
+		assert(block_length > 0);
+		assert(block_length <= 2 * block_size);
+		if (block->next)
+			assert(block->next->prev == block);
+		else
+			assert(block == tail);
+		block->items.debug_verfiy_data_integrity();
+		total += block_length;
+	}
+	assert(total == length);
+	assert(blocks == block_count);
+	if (adaptive) {
+		assert(length <= 4LL * block_size * block_size);
+		assert(block_size == min_block_size || 4LL * length >= (long long)block_size * block_size);
+	}
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "DoublyLinkedList.h"
+
+/**
+ * @brief Indexable list made of a doubly linked list of LinkedList blocks
+ *
+ * Each block is an ordinary LinkedList holding up to 2 * block_size nodes,
+ * and the blocks themselves are linked in both directions. Positional
+ * operations first skip whole blocks using their lengths, then walk inside
+ * a single block, so with block_size close to sqrt(n) every positional
+ * operation costs O(sqrt(n)) instead of O(n).
+ *
+ * By default the block size follows the length: whenever n leaves
+ * [block_size^2 / 4, 4 * block_size^2] the list is re-blocked with
+ * block_size = sqrt(n). Re-blocking costs O(n), and at least about 3n / 4
+ * more inserts or deletes happen before the next one, so positional
+ * operations stay O(sqrt(n)) amortized without tuning. A block size passed to
+ * the constructor is kept fixed instead.
+ *
+ * Block rules:
+ * - A block that grows past 2 * block_size is split in two halves
+ * - An empty block is removed
+ * - Two neighbours that fit in block_size together are merged
+ *
+ * Together these keep the number of blocks at O(n / block_size).
+ */
+class TieredList {
+private:
+	struct Block
+	{
+		LinkedList items;	///< Nodes of this block in list order
+		Block* next{};		///< Next block (nullptr if last)
+		Block* prev{};		///< Previous block (nullptr if first)
+	};
+
+	Block* head{};			///< First block
+	Block* tail{};			///< Last block
+	int length = 0;			///< Total number of nodes across all blocks
+	int block_count = 0;	///< Number of blocks
+	int block_size{};		///< Target number of nodes per block
+	bool adaptive{};		///< block_size follows sqrt(length)
+
+	static const int min_block_size = 8;	///< Smallest adaptive block size
+
+	/**
+	 * @brief Helper function to link two blocks bidirectionally
+	 */
+	void link(Block* first, Block* second);
+
+	/**
+	 * @brief Inserts a new empty block after node_before (or at the front)
+	 * @param node_before Block to insert after, nullptr for the front
+	 * @return The new block
+	 */
+	Block* embed_block_after(Block* node_before);
+
+	/**
+	 * @brief Unlinks and deletes a block (its nodes are deleted with it)
+	 */
+	void delete_block(Block* block);
+
+	/**
+	 * @brief Finds the block holding position n, walking from the nearest end
+	 * @param n Position in the whole list (1-indexed); becomes the position inside the block
+	 * @return Block holding the node
+	 */
+	Block* find_block(int& n);
+
+	/**
+	 * @brief Splits a block in two halves once it grows past 2 * block_size
+	 */
+	void split_if_full(Block* block);
+
+	/**
+	 * @brief Removes an empty block or merges it with a small neighbour
+	 */
+	void merge_if_sparse(Block* block);
+
+	/**
+	 * @brief Re-blocks the list when the length left [block_size^2 / 4, 4 * block_size^2]
+	 * @details Only for adaptive lists; call after every length change
+	 */
+	void rebalance_if_needed();
+
+	/**
+	 * @brief Redistributes all nodes into blocks of exactly new_block_size (the last may be shorter)
+	 * @details Nodes are moved, not copied, so Node pointers stay valid
+	 * @complexity O(n)
+	 */
+	void reblock(int new_block_size);
+
+public:
+	/**
+	 * @brief Creates an empty list
+	 * @param block_size Fixed target nodes per block, or 0 to keep it at about sqrt(length)
+	 */
+	TieredList(int block_size = 0);
+
+	/**
+	 * @brief Destructor - deletes every block and node
+	 */
+	~TieredList();
+
+	// Disable copy operations to prevent shallow copying issues
+	TieredList(const TieredList&) = delete;
+	TieredList& operator=(const TieredList&) = delete;
+
+	/**
+	 * @brief Gets the total number of nodes
+	 * @return Number of nodes, O(1)
+	 */
+	int get_length() const;
+
+	/**
+	 * @brief Gets the number of blocks (for tests and tuning)
+	 */
+	int get_block_count() const;
+
+	/**
+	 * @brief Gets the current target block size (for tests and tuning)
+	 */
+	int get_block_size() const;
+
+	/**
+	 * @brief Gets the nth node from the beginning (1-indexed)
+	 * @param n Position from the start
+	 * @return Pointer to the nth node, or nullptr if n <= 0 or n > length
+	 */
+	Node* get_nth(int n);
+
+	/**
+	 * @brief Inserts a value so that it becomes the nth node (1-indexed)
+	 * @param n Target position, 1..length + 1 (other values are ignored)
+	 * @param val Value to insert
+	 */
+	void insert_at(int n, int val);
+
+	/**
+	 * @brief Deletes the nth node (1-indexed)
+	 * @param n Position to delete (out-of-range values are ignored)
+	 */
+	void delete_at(int n);
+
+	/**
+	 * @brief Inserts a value at the beginning of the list
+	 */
+	void insert_front(int val);
+
+	/**
+	 * @brief Inserts a value at the end of the list
+	 */
+	void insert_end(int val);
+
+	/**
+	 * @brief Prints all values from first to last
+	 */
+	void print();
+
+	/**
+	 * @brief Converts the list to a space-separated string representation
+	 */
+	string debug_to_string();
+
+	/**
+	 * @brief Verifies block links, lengths and block size rules
+	 */
+	void debug_verify_data_integrity();
+};
@@ -0,0 +1,167 @@
+/**
+ * @file PersistentList.cpp
+ * @brief Implementation of the persistent singly linked list
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include "PersistentList.h"
+
+using namespace std;
+
+// ===== Constructor / Destructor =====
+PersistentList::PersistentList() {}
+
+PersistentList::PersistentList(shared_ptr<Node> head, int length) : head(std::move(head)), length(length) {}
+
+PersistentList& PersistentList::operator=(PersistentList other)
+{
+    // The old chain is released by other's destructor
+    swap(head, other.head);
+    swap(length, other.length);
+    return *this;
+}
+
+PersistentList::~PersistentList()
+{ // O(k) time - O(1) memory
+    // Stop at the first node another version still references
+    while (head && head.use_count() == 1)
+    {
+        shared_ptr<Node> next = std::move(head->next);
+        head = std::move(next);
+    }
+}
+
+// ===== Access =====
+int PersistentList::get_length() const
+{
+    return length;
+}
+
+bool PersistentList::is_empty() const
+{
+    return length == 0;
+}
+
+int PersistentList::front() const
+{
+    assert(head);
+    return head->data;
+}
+
+const PersistentList::Node* PersistentList::get_nth(int n) const
+{ // O(n) time - O(1) memory
+    if (n <= 0 || n > length)
+        return nullptr;
+    const Node* cur = head.get();
+    while (--n)
+        cur = cur->next.get();
+    return cur;
+}
+
+// ===== New versions =====
+PersistentList PersistentList::insert_front(int val) const
+{ // O(1) time - O(1) memory
+    return PersistentList(make_shared<Node>(val, head), length + 1);
+}
+
+PersistentList PersistentList::delete_front() const
+{ // O(1) time - O(1) memory
+    if (!head)
+        return *this;
+    return PersistentList(head->next, length - 1);
+}
+
+PersistentList PersistentList::insert_at(int n, int val) const
+{ // O(n) time - O(n) memory
+    if (n <= 0 || n > length + 1)
+        return *this;
+
+    // Copy the first n - 1 nodes; the rest hangs off the new node unchanged
+    shared_ptr<Node> new_head;
+    shared_ptr<Node>* last = &new_head;
+    const shared_ptr<Node>* rest = &head;
+    for (int i = 1; i < n; ++i, rest = &(*rest)->next)
+    {
+        *last = make_shared<Node>((*rest)->data, nullptr);
+        last = &(*last)->next;
+    }
+    *last = make_shared<Node>(val, *rest);
+
+    return PersistentList(new_head, length + 1);
+}
+
+PersistentList PersistentList::delete_at(int n) const
+{ // O(n) time - O(n) memory
+    if (n <= 0 || n > length)
+        return *this;
+
+    shared_ptr<Node> new_head;
+    shared_ptr<Node>* last = &new_head;
+    const Node* cur = head.get();
+    for (int i = 1; i < n; ++i, cur = cur->next.get())
+    {
+        *last = make_shared<Node>(cur->data, nullptr);
+        last = &(*last)->next;
+    }
+    *last = cur->next; // skip the nth node, share everything after it
+
+    return PersistentList(new_head, length - 1);
+}
+
+PersistentList PersistentList::rotate_left(int k) const
+{ // O(n) time - O(n) memory
+    if (length <= 1)
+        return *this;
+    k %= length;
+    if (k < 0)
+        k += length;
+    if (k == 0)
+        return *this;
+
+    // Nodes k+1..n come first, then nodes 1..k
+    shared_ptr<Node> new_head;
+    shared_ptr<Node>* last = &new_head;
+    const Node* split = get_nth(k + 1);
+    for (const Node* cur = split; cur; cur = cur->next.get())
+    {
+        *last = make_shared<Node>(cur->data, nullptr);
+        last = &(*last)->next;
+    }
+    for (const Node* cur = head.get(); cur != split; cur = cur->next.get())
+    {
+        *last = make_shared<Node>(cur->data, nullptr);
+        last = &(*last)->next;
+    }
+
+    return PersistentList(new_head, length);
+}
+
+// ===== Display / Debug =====
+void PersistentList::print() const
+{
+    for (const Node* cur = head.get(); cur; cur = cur->next.get())
+        cout << cur->data << " ";
+    cout << "\n";
+}
+
+string PersistentList::debug_to_string() const
+{
+    ostringstream oss;
+    for (const Node* cur = head.get(); cur; cur = cur->next.get())
+    {
+        oss << cur->data;
+        if (cur->next)
+            oss << " ";
+    }
+    return oss.str();
+}
+
+void PersistentList::debug_verify_data_integrity() const
+{
+    int len = 0;
+    for (const Node* cur = head.get(); cur; cur = cur->next.get())
+        ++len;
+    assert(len == length);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file PersistentList.h
+ * @brief Immutable singly linked list whose versions share their tails
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using std::string;
+
+/**
+ * @class PersistentList
+ * @brief Persistent (immutable, structurally shared) singly linked list
+ * @details A PersistentList value never changes. Operations return a new
+ *          version that reuses every node it can from the old one: a new
+ *          front node points at the old head, and dropping the front just
+ *          starts one node later. Nodes are reference counted, so a node
+ *          lives as long as any version still reaches it.
+ *
+ *          Copying a list is O(1) time and memory, which makes it a cheap
+ *          snapshot. Nodes are never modified after they are published, so
+ *          readers of a snapshot need no locks while a writer keeps building
+ *          new versions; only the variable the writer publishes to must be
+ *          shared safely.
+ *
+ * Example:
+ * @code
+ * PersistentList v1 = PersistentList().insert_front(3).insert_front(2);
+ * PersistentList v2 = v1.insert_front(1);   // "1 2 3", shares "2 3" with v1
+ * PersistentList v3 = v2.delete_front();    // "2 3", the very same nodes as v1
+ * @endcode
+ */
+class PersistentList
+{
+public:
+    /**
+     * @brief Immutable list node
+     */
+    struct Node
+    {
+        int data{};                  ///< Integer data stored in the node
+        std::shared_ptr<Node> next;  ///< Next node (shared between versions)
+
+        Node(int data, std::shared_ptr<Node> next) : data(data), next(std::move(next)) {}
+    };
+
+private:
+    std::shared_ptr<Node> head; ///< First node (nullptr for the empty list)
+    int length = 0;             ///< Number of nodes reachable from head
+
+    /**
+     * @brief Wraps an existing chain of nodes
+     */
+    PersistentList(std::shared_ptr<Node> head, int length);
+
+public:
+    /**
+     * @brief Creates an empty list
+     */
+    PersistentList();
+
+    /**
+     * @brief Copy constructor - O(1) snapshot sharing every node
+     */
+    PersistentList(const PersistentList&) = default;
+
+    /**
+     * @brief Move constructor
+     */
+    PersistentList(PersistentList&&) noexcept = default;
+
+    /**
+     * @brief Replaces this version with another (O(1) plus releasing unshared nodes)
+     */
+    PersistentList& operator=(PersistentList other);
+
+    /**
+     * @brief Releases the nodes no other version uses
+     * @details Unwinds the chain iteratively so long lists cannot overflow the stack
+     * @complexity O(k) for the k nodes owned only by this version
+     */
+    ~PersistentList();
+
+    /**
+     * @brief Gets the number of elements
+     * @complexity O(1)
+     */
+    int get_length() const;
+
+    /**
+     * @brief Checks whether the list is empty
+     */
+    bool is_empty() const;
+
+    /**
+     * @brief Gets the first value (list must not be empty)
+     * @complexity O(1)
+     */
+    int front() const;
+
+    /**
+     * @brief Gets the nth node (1-indexed)
+     * @return Pointer to the node, or nullptr if n is out of range
+     * @complexity O(n)
+     */
+    const Node* get_nth(int n) const;
+
+    /**
+     * @brief Returns a version with val in front of this one
+     * @complexity O(1) time - O(1) memory, the whole list is shared
+     */
+    PersistentList insert_front(int val) const;
+
+    /**
+     * @brief Returns a version without the first element (empty stays empty)
+     * @complexity O(1) time - O(1) memory, the remaining nodes are shared
+     */
+    PersistentList delete_front() const;
+
+    /**
+     * @brief Returns a version with val inserted so it becomes the nth element
+     * @param n Target position, 1..length + 1 (other values return this version)
+     * @complexity O(n) time - O(n) memory, nodes after the insertion point are shared
+     */
+    PersistentList insert_at(int n, int val) const;
+
+    /**
+     * @brief Returns a version without the nth element
+     * @param n Position to delete (out-of-range values return this version)
+     * @complexity O(n) time - O(n) memory, nodes after the deleted one are shared
+     */
+    PersistentList delete_at(int n) const;
+
+    /**
+     * @brief Returns a version rotated left by k positions
+     * @details The old tail points nowhere, so the rotated version cannot share it;
+     *          every node is copied once
+     * @complexity O(n) time - O(n) memory
+     */
+    PersistentList rotate_left(int k) const;
+
+    /**
+     * @brief Prints the list values
+     */
+    void print() const;
+
+    /**
+     * @brief Converts the list to a space-separated string
+     */
+    string debug_to_string() const;
+
+    /**
+     * @brief Verifies that length matches the reachable chain
+     */
+    void debug_verify_data_integrity() const;
+};
@@ -18,6 +18,8 @@ using namespace std;
 void LinkedList::debug_add_node(Node* node)
 {
     debug_data.push_back(node);
+    if (in_batch)
+        undo_tracking.emplace_back(node, true);
 }
 
 void LinkedList::debug_remove_node(Node* node)
@@ -26,17 +28,57 @@ void LinkedList::debug_remove_node(Node* node)
     if (it == debug_data.end())
         cout << "Node does not exist\n";
     else
+    {
         debug_data.erase(it);
+        if (in_batch)
+            undo_tracking.emplace_back(node, false);
+    }
+}
+
+void LinkedList::release_batch(vector<Node*>& removed)
+{
+    // One bookkeeping pass for the whole batch
+    set_value(length, length - (int)removed.size());
+    unordered_set<Node*> removed_set(removed.begin(), removed.end());
+    debug_data.erase(remove_if(debug_data.begin(), debug_data.end(),
+        [&removed_set](Node* node) { return removed_set.count(node) != 0; }), debug_data.end());
+
+    if (in_batch)
+    {
+        // Freed on commit, relinked on rollback
+        for (Node* node : removed)
+        {
+            undo_tracking.emplace_back(node, false);
+            batch_released.push_back(node);
+        }
+        return;
+    }
+
+    for (Node* node : removed)
+        release_node(node);
+
+    debug_verify_data_integrity();
+}
+
+Node* LinkedList::create_node(int val)
+{
+    DS_STATS_ALLOC(sizeof(Node));
+    Node* item = arena.create(val);
+    if (in_batch)
+        batch_created.push_back(item); // deleted on rollback
+    return item;
 }
 
 // ===== Constructor / Destructor =====
 LinkedList::LinkedList() {}
 LinkedList::~LinkedList()
 {
+    if (in_batch)
+        rollback();
     while (head)
     {
         Node* cur = head->next;
-        delete head;
+        arena.destroy(head);
         head = cur;
     }
     cout << "\nDestructor called\n"
@@ -96,6 +138,9 @@ string LinkedList::debug_to_string()
 }
 void LinkedList::debug_verify_data_integrity()
 {
+    if (in_batch)
+        return; // checked once by commit()
+
     if (length == 0)
     {
         assert(head == nullptr);
@@ -122,12 +167,79 @@ void LinkedList::debug_verify_data_integrity()
     assert(length == (int)debug_data.size());
 }
 
+// ===== Batches =====
+void LinkedList::begin_batch()
+{ // O(1) time
+    assert(!in_batch); // batches do not nest
+    in_batch = true;
+}
+void LinkedList::commit()
+{ // O(d) time for d deleted nodes
+    DS_STATS_OP("commit");
+    assert(in_batch);
+    in_batch = false;
+
+    for (Node* node : batch_released)
+        release_node(node);
+    clear_batch();
+
+    debug_verify_data_integrity();
+}
+void LinkedList::rollback()
+{ // O(w) time for w logged writes
+    DS_STATS_OP("rollback");
+    assert(in_batch);
+    in_batch = false;
+
+    // Newest first, so a field written twice ends with its oldest value
+    for (auto it = undo_links.rbegin(); it != undo_links.rend(); ++it)
+        *it->first = it->second;
+    for (auto it = undo_values.rbegin(); it != undo_values.rend(); ++it)
+        *it->first = it->second;
+    for (auto it = undo_tracking.rbegin(); it != undo_tracking.rend(); ++it)
+    {
+        if (it->second)
+            debug_data.erase(find(debug_data.begin(), debug_data.end(), it->first));
+        else
+            debug_data.push_back(it->first);
+    }
+
+    // Deleted nodes are linked again by the restored pointers; created ones go
+    for (Node* node : batch_created)
+        release_node(node);
+    clear_batch();
+
+    debug_verify_data_integrity();
+}
+bool LinkedList::is_batch_open() const
+{
+    return in_batch;
+}
+void LinkedList::clear_batch()
+{
+    undo_links.clear();
+    undo_values.clear();
+    undo_tracking.clear();
+    batch_created.clear();
+    batch_released.clear();
+}
+
 // ===== Operations =====
 void LinkedList::delete_node(Node* node)
 {
     debug_remove_node(node); // for debug
-    --length;
-    delete node;
+    set_value(length, length - 1);
+    if (in_batch)
+    {
+        batch_released.push_back(node); // freed on commit, relinked on rollback
+        return;
+    }
+    release_node(node);
+}
+void LinkedList::release_node(Node* node)
+{
+    DS_STATS_FREE(sizeof(Node));
+    arena.destroy(node);
 }
 void LinkedList::delete_next_node(Node* node)
 {
@@ -137,20 +249,20 @@ void LinkedList::delete_next_node(Node* node)
 
     bool is_tail = to_delete == tail;
 
-    node->next = to_delete->next;
+    set_link(node->next, to_delete->next);
 
     delete_node(to_delete);
 
     if (is_tail)
-        tail = node;
+        set_link(tail, node);
 }
 void LinkedList::embed_after(Node* node, int val)
 {
-    Node* item = new Node(val);
-    ++length;
+    Node* item = create_node(val);
+    set_value(length, length + 1);
     debug_add_node(item);
     item->next = node->next;
-    node->next = item;
+    set_link(node->next, item);
 }
 
 void LinkedList::print()
@@ -167,41 +279,43 @@ void LinkedList::swap_head_and_tail()
 
     if (length == 2)
     {
-        tail->next = head;
-        head->next = nullptr;
-        swap(head, tail);
+        set_link(tail->next, head);
+        set_link(head->next, nullptr);
+        swap_links(head, tail);
     }
     else
     {
         auto prv = get_nth(length - 1);
-        tail->next = head->next;
+        set_link(tail->next, head->next);
 
-        prv->next = head;
-        head->next = nullptr;
+        set_link(prv->next, head);
+        set_link(head->next, nullptr);
 
-        swap(head, tail);
+        swap_links(head, tail);
 
         debug_verify_data_integrity();
     }
 }
 void LinkedList::rotate_left(int k)
 { // O(n) time - O(1) memory
+    DS_STATS_OP("rotate_left");
     if (length <= 1 || k % length == 0)
         return;
 
     k %= length;
 
     auto nth = get_nth(k);
-    tail->next = head; // create cycle
+    set_link(tail->next, head); // create cycle
 
-    tail = nth;
-    head = nth->next;
+    set_link(tail, nth);
+    set_link(head, nth->next);
 
-    tail->next = nullptr;
+    set_link(tail->next, nullptr);
     debug_verify_data_integrity();
 }
 void LinkedList::remove_duplicates()
 { // O(n^2) time - O(1) memory
+    DS_STATS_OP("remove_duplicates");
     if (length <= 1)
         return;
 
@@ -209,6 +323,7 @@ void LinkedList::remove_duplicates()
     {
         for (Node* cur2 = cur1->next, *prv = cur1; cur2;)
         {
+            DS_STATS_STEP();
             if (cur1->data == cur2->data)
             {
                 delete_next_node(prv);
@@ -223,6 +338,7 @@ void LinkedList::remove_duplicates()
 }
 void LinkedList::remove_duplicates2()
 { // O(n) time - O(n) memory
+    DS_STATS_OP("remove_duplicates2");
     if (length <= 1)
         return;
 
@@ -275,27 +391,31 @@ void LinkedList::remove_last_occurence(int key)
     debug_verify_data_integrity();
 }
 int LinkedList::max(Node* head, bool is_first_call)
-{ // O(n) time - O(n) memory
+{ // O(n) time - O(1) memory
+    DS_STATS_OP("max");
     if (is_first_call)
-        return this->max(this->head, false);
+        head = this->head;
 
-    if (head == nullptr)
-        return INT_MIN;
-
-    return std::max(head->data, this->max(head->next, false));
+    int result = INT_MIN;
+    for (Node* cur = head; cur; cur = cur->next)
+    {
+        DS_STATS_STEP();
+        result = std::max(result, cur->data);
+    }
+    return result;
 }
 Node* LinkedList::move_to_end(Node* cur, Node* prv)
 {
     Node* next = cur->next;
-    tail->next = cur;
+    set_link(tail->next, cur);
 
     if (prv)
-        prv->next = next;
+        set_link(prv->next, next);
     else
-        head = next;
+        set_link(head, next);
 
-    tail = cur;
-    tail->next = nullptr;
+    set_link(tail, cur);
+    set_link(tail->next, nullptr);
 
     return next;
 }
@@ -328,15 +448,15 @@ void LinkedList::odd_pos_even_pos()
     {
         Node* next_even = cur_odd->next;
 
-        cur_odd->next = cur_odd->next->next;
-        next_even->next = next_even->next->next;
+        set_link(cur_odd->next, cur_odd->next->next);
+        set_link(next_even->next, next_even->next->next);
 
         cur_odd = cur_odd->next;
         if (length % 2 == 1)
-            tail = next_even;
+            set_link(tail, next_even);
     }
 
-    cur_odd->next = first_even;
+    set_link(cur_odd->next, first_even);
 
     debug_verify_data_integrity();
 }
@@ -344,22 +464,27 @@ void LinkedList::odd_pos_even_pos()
 void LinkedList::insert_after(Node* src, Node* target)
 {
     assert(src && target);
-    target->next = src->next;
-    src->next = target;
+    set_link(target->next, src->next);
+    set_link(src->next, target);
     debug_add_node(target);
-    ++length;
+    set_value(length, length + 1);
 }
 void LinkedList::insert_alternate(LinkedList& anthor)
 { // O(n) time - O(1) memory
+    DS_STATS_OP("insert_alternate");
     if (!anthor.length)
         return;
 
+    // Every node of anthor ends up linked into this list
+    DS_STATS_MOVE_NODES(anthor, anthor.length, sizeof(Node));
+
     if (!length)
     {
-        head = anthor.head;
-        tail = anthor.tail;
-        length = anthor.length;
-        debug_data = anthor.debug_data;
+        set_link(head, anthor.head);
+        set_link(tail, anthor.tail);
+        set_value(length, anthor.length);
+        for (Node* node : anthor.debug_data)
+            debug_add_node(node);
     }
     else
     {
@@ -368,14 +493,14 @@ void LinkedList::insert_alternate(LinkedList& anthor)
         {
             Node* cur2_next_temp = cur2->next;
             insert_after(cur1, cur2);
-            anthor.length--;
+            set_value(anthor.length, anthor.length - 1);
             cur2 = cur2_next_temp;
 
             if (cur1 == tail)
             {
-                tail = anthor.tail;
-                cur1->next->next = cur2;
-                length += anthor.length;
+                set_link(tail, anthor.tail);
+                set_link(cur1->next->next, cur2);
+                set_value(length, length + anthor.length);
                 break;
             }
 
@@ -415,7 +540,7 @@ void LinkedList::add_num(LinkedList& anthor)
 
         if (my_cur)
         {
-            my_cur->data = my_value;
+            set_value(my_cur->data, my_value);
             my_cur = my_cur->next;
         }
         else
@@ -462,30 +587,7 @@ void LinkedList::move_key_occurence_back2(int key)
 }
 void LinkedList::remove_all_repeated_of_k(int k)
 { // O(n) time - O(1) memory
-    if (!length)
-        return;
-
-    for (Node* cur = head, *prv = nullptr; cur;)
-    {
-        if (cur->data == k)
-        {
-            if (prv)
-            {
-                delete_next_node(prv);
-                cur = prv->next;
-            }
-            else
-            {
-                cur = cur->next;
-                delete_front();
-            }
-        }
-        else
-        {
-            prv = cur;
-            cur = cur->next;
-        }
-    }
+    erase_if([k](int data) { return data == k; });
 
     debug_verify_data_integrity();
 }
@@ -494,34 +596,38 @@ void LinkedList::remove_all_repeated_of_k(int k)
 void LinkedList::add_node(Node* node)
 {
     debug_add_node(node);
-    ++length;
+    set_value(length, length + 1);
 }
 void LinkedList::insert_end(int val)
 {
-    Node* item = new Node(val);
+    DS_STATS_OP("insert_end");
+    Node* item = create_node(val);
 
     add_node(item); // for debug
 
     if (!head)
-        head = tail = item;
+        set_link(head, item);
     else
-        tail->next = item, tail = item;
+        set_link(tail->next, item);
+    set_link(tail, item);
 }
 void LinkedList::insert_front(int val)
 { // time o(1) - memory o(1)
-    Node* item = new Node(val);
+    DS_STATS_OP("insert_front");
+    Node* item = create_node(val);
     add_node(item);
 
     item->next = head;
-    head = item;
+    set_link(head, item);
 
     if (length == 1)
-        tail = head;
+        set_link(tail, head);
 
     debug_verify_data_integrity();
 }
 void LinkedList::insert_sorted(int val)
 { // O(N) time - O(1) memory
+    DS_STATS_OP("insert_sorted");
     if (!length || val <= head->data)
         insert_front(val);
     else if (val >= tail->data)
@@ -530,6 +636,7 @@ void LinkedList::insert_sorted(int val)
     {
         for (Node* cur = head, *prv = nullptr; cur; prv = cur, cur = cur->next)
         {
+            DS_STATS_STEP();
             if (cur->data >= val)
             {
                 embed_after(prv, val);
@@ -541,14 +648,16 @@ void LinkedList::insert_sorted(int val)
 }
 void LinkedList::delete_front()
 { // time o(1) - memory o(1)
+    DS_STATS_OP("delete_front");
     Node* cur = head->next;
     delete_node(head);
-    head = cur;
+    set_link(head, cur);
 
     debug_verify_data_integrity();
 }
 void LinkedList::delete_back()
 { // time o(n) - memory o(1)
+    DS_STATS_OP("delete_back");
     if (length <= 1)
     {
         delete_front();
@@ -557,13 +666,14 @@ void LinkedList::delete_back()
 
     Node* prev = get_nth(length - 1);
     delete_node(tail);
-    tail = prev;
-    tail->next = nullptr;
+    set_link(tail, prev);
+    set_link(tail->next, nullptr);
 
     debug_verify_data_integrity();
 }
 void LinkedList::delete_nth_node(int index)
 { // time o(n) - memory o(1)
+    DS_STATS_OP("delete_nth_node");
     if (index < 0 || index > length)
         cout << "Error: index out of bounds\n";
     else if (index == 1)
@@ -575,7 +685,7 @@ void LinkedList::delete_nth_node(int index)
         Node* prev = get_nth(index - 1);
         Node* nth = prev->next;
 
-        prev->next = nth->next;
+        set_link(prev->next, nth->next);
 
         delete_node(nth);
         debug_verify_data_integrity();
@@ -584,6 +694,7 @@ void LinkedList::delete_nth_node(int index)
 // Delete the first node with the given key value
 void LinkedList::delete_node_with_key(int val)
 { // time o(n) - memory o(1)
+    DS_STATS_OP("delete_node_with_key");
     if (!length)
         cout << "Error: Empty List\n";
     else if (head->data == val)
@@ -592,6 +703,7 @@ void LinkedList::delete_node_with_key(int val)
     {
         for (Node* cur = head, *prev = nullptr; cur; prev = cur, cur = cur->next)
         {
+            DS_STATS_STEP();
             if (cur->data == val)
             {
                 delete_next_node(prev); // connect prv with after
@@ -605,6 +717,7 @@ void LinkedList::delete_node_with_key(int val)
 }
 void LinkedList::delete_even_positions()
 { // O(N) time - O(1) memory
+    DS_STATS_OP("delete_even_positions");
     if (length <= 1)
         return;
 
@@ -623,12 +736,16 @@ void LinkedList::delete_even_positions()
 }
 Node* LinkedList::get_nth(int n)
 {
+    DS_STATS_OP("get_nth");
     // time o(n) - memory o(1)
     int i = 1;
 
     for (Node* cur = head; cur != nullptr && i <= n; cur = cur->next)
+    {
+        DS_STATS_STEP();
         if (i++ == n)
             return cur;
+    }
 
     return nullptr; // not found
 }
@@ -640,27 +757,84 @@ Node* LinkedList::get_nth_back(int n)
 }
 int LinkedList::search(int val)
 { // time o(n) - memory o(1)
+    DS_STATS_OP("search");
     // One-index
     int i = 1;
     for (Node* cur = head; cur != nullptr; cur = cur->next, i++)
+    {
+        DS_STATS_STEP();
         if (cur->data == val)
             return i;
+    }
 
     return -1; // not found
 }
+vector<int> LinkedList::search_batch(const vector<int>& vals)
+{ // time o(n + k) - memory o(k)
+    DS_STATS_OP("search_batch");
+    vector<int> positions(vals.size(), -1);
+
+    // value -> indices in vals still waiting for it
+    unordered_map<int, vector<int>> pending;
+    for (int k = 0; k < (int)vals.size(); ++k)
+        pending[vals[k]].push_back(k);
+
+    int i = 1;
+    for (Node* cur = head; cur != nullptr && !pending.empty(); cur = cur->next, i++)
+    {
+        DS_STATS_STEP();
+        auto it = pending.find(cur->data);
+        if (it == pending.end())
+            continue;
+        for (int k : it->second)
+            positions[k] = i;
+        pending.erase(it);
+    }
+
+    return positions;
+}
+vector<Node*> LinkedList::get_nth_batch(const vector<int>& positions)
+{ // time o(n + k log k) - memory o(k)
+    DS_STATS_OP("get_nth_batch");
+    vector<Node*> nodes(positions.size(), nullptr);
+
+    // Answer the requests in position order during one walk
+    vector<int> order(positions.size());
+    for (int k = 0; k < (int)order.size(); ++k)
+        order[k] = k;
+    sort(order.begin(), order.end(), [&positions](int a, int b) { return positions[a] < positions[b]; });
+
+    int next = 0;
+    while (next < (int)order.size() && positions[order[next]] <= 0)
+        ++next; // out of range, stays nullptr
+
+    int i = 1;
+    for (Node* cur = head; cur != nullptr && next < (int)order.size(); cur = cur->next, i++)
+    {
+        DS_STATS_STEP();
+        while (next < (int)order.size() && positions[order[next]] == i)
+            nodes[order[next++]] = cur;
+    }
+
+    return nodes;
+}
 int LinkedList::search_improved(int val)
 {
+    DS_STATS_OP("search_improved");
     // // One-index and shift the element by one to left if found return the new position
     if (head->data == val)
         return 1;
 
     int i = 1;
     for (Node* cur = head; cur->next != nullptr; cur = cur->next, i++)
+    {
+        DS_STATS_STEP();
         if (cur->next->data == val)
         {
-            swap(cur->next->data, cur->data);
+            swap_values(cur->next->data, cur->data);
             return i;
         }
+    }
 
     return -1;
 }
@@ -704,33 +878,34 @@ void LinkedList::swap_pairs()
     {
         if (cur->next)
         {
-            swap(cur->data, cur->next->data);
+            swap_values(cur->data, cur->next->data);
             cur = cur->next;
         }
     }
 }
 void LinkedList::reverse()
 { // O(N) time - O(1) memory
+    DS_STATS_OP("reverse");
     if (length <= 1)
         return;
 
-    tail = head;
     Node* prv = head;
-    head = head->next;
+    Node* cur = head->next;
 
-    while (head)
+    while (cur)
     {
+        DS_STATS_STEP();
         // store and reverse
-        Node* next = head->next;
-        head->next = prv;
+        Node* next = cur->next;
+        set_link(cur->next, prv);
 
         // move step
-        prv = head;
-        head = next;
+        prv = cur;
+        cur = next;
     }
 
-    head = prv;
-    tail->next = nullptr;
+    swap_links(head, tail);
+    set_link(tail->next, nullptr);
 
     debug_verify_data_integrity();
 }
@@ -740,6 +915,7 @@ void LinkedList::reverse()
 // elements not sorted
 void LinkedList::remove_all_repeated()
 {
+    DS_STATS_OP("remove_all_repeated");
     if (length <= 1)
         return;
 
@@ -782,6 +958,7 @@ Node* LinkedList::move_and_delete(Node* cur)
 }
 void LinkedList::remove_all_repeated_from_sorted()
 {
+    DS_STATS_OP("remove_all_repeated_from_sorted");
     if (length <= 1)
         return;
 
@@ -805,24 +982,24 @@ void LinkedList::remove_all_repeated_from_sorted()
         if (removed)
         {
             if (prv)
-                prv->next = cur;
+                set_link(prv->next, cur);
             else
-				head = cur;
+                set_link(head, cur);
 
             if (!cur)
-                tail = prv;
+                set_link(tail, prv);
         }
         else
         {
             prv = cur;
             cur = cur->next;
-            tail = prv;
+            set_link(tail, prv);
         }
     }
 
 
     if (!head) // list became empty
-        tail = head;
+        set_link(tail, head);
 
     debug_verify_data_integrity();
 }
@@ -835,7 +1012,7 @@ pair<Node*, pair<Node*, Node*>> LinkedList::reverse_subchain(Node* cur_head, int
     for (int i = 1; i < k - 1 && cur_head; i++)
     {
         Node* next = cur_head->next;
-        cur_head->next = prv;
+        set_link(cur_head->next, prv);
 
         prv = cur_head;
         cur_head = next;
@@ -849,21 +1026,37 @@ void LinkedList::reverse_chains(int k)
 
     Node* last_tail = nullptr;
     Node* next_chain_head = head;
-    head = nullptr;
+    set_link(head, nullptr);
     while (next_chain_head)
     {
         auto p = reverse_subchain(next_chain_head, k);
         Node* chain_head = p.first;
         Node* chain_tail = p.second.first;
         next_chain_head = p.second.second;
-        tail = chain_tail;
+        set_link(tail, chain_tail);
 
         if (!head) // first chain
-            head = chain_head;
+            set_link(head, chain_head);
         else
-            last_tail->next = chain_head;
+            set_link(last_tail->next, chain_head);
         last_tail = chain_tail;
     }
-    tail->next = nullptr;
+    set_link(tail->next, nullptr);
     debug_verify_data_integrity();
 }
+#ifdef DS_HAS_COROUTINES
+Generator<int> LinkedList::values() const
+{ // O(n) time - O(1) memory
+    for (Node* cur = head; cur; cur = cur->next)
+        co_yield cur->data;
+}
+Generator<Node*> LinkedList::nodes() const
+{ // O(n) time - O(1) memory
+    for (Node* cur = head; cur;)
+    {
+        Node* next = cur->next;
+        co_yield cur;
+        cur = next;
+    }
+}
+#endif
@@ -19,6 +19,9 @@
 #include <algorithm>
 
 #include "Node.h"
+#include "../Common/ContainerStats.h"
+#include "../Common/NodeArena.h"
+#include "../Common/Generator.h"
 
 using std::vector;
 using std::string;
@@ -44,6 +47,18 @@ private:
     // Debug utilities for development and testing
     vector<Node*> debug_data; ///< Vector to track all nodes for debugging purposes
 
+    NodeArena<Node> arena; ///< Slabs every node is allocated from (see NodeArena.h)
+
+    DS_STATS_MEMBER ///< Memory and operation counters (only with DS_ENABLE_STATS)
+
+    // Undo log of the open batch (see begin_batch)
+    bool in_batch = false;                   ///< A batch is open
+    vector<pair<Node**, Node*>> undo_links;  ///< Overwritten head/tail/next fields and their old values
+    vector<pair<int*, int>> undo_values;     ///< Overwritten length/data fields and their old values
+    vector<pair<Node*, bool>> undo_tracking; ///< debug_data changes (node, added)
+    vector<Node*> batch_created;             ///< Nodes allocated in the batch, deleted on rollback
+    vector<Node*> batch_released;            ///< Nodes deleted in the batch, freed on commit
+
     // Helper debug functions
 
     /**
@@ -58,6 +73,67 @@ private:
      */
     void debug_remove_node(Node* node);
 
+    /**
+     * @brief Reclaims a batch of already unlinked nodes
+     * @param removed Unlinked nodes
+     * @details Updates length and debug tracking once for the whole batch
+     */
+    void release_batch(vector<Node*>& removed);
+
+    /**
+     * @brief Destroys a node and keeps its slot in the arena for reuse
+     */
+    void release_node(Node* node);
+
+    /**
+     * @brief Allocates a node and records it when a batch is open
+     * @param val Value of the new node
+     */
+    Node* create_node(int val);
+
+    /**
+     * @brief Writes a pointer field, logging its old value when a batch is open
+     * @param field head, tail or a node's next
+     * @param value New value
+     */
+    void set_link(Node*& field, Node* value)
+    {
+        if (in_batch)
+            undo_links.emplace_back(&field, field);
+        field = value;
+    }
+
+    /**
+     * @brief Writes a length or data field, logging its old value when a batch is open
+     * @param field length or a node's data
+     * @param value New value
+     */
+    void set_value(int& field, int value)
+    {
+        if (in_batch)
+            undo_values.emplace_back(&field, field);
+        field = value;
+    }
+
+    void swap_links(Node*& a, Node*& b)
+    {
+        Node* old_a = a;
+        set_link(a, b);
+        set_link(b, old_a);
+    }
+
+    void swap_values(int& a, int& b)
+    {
+        int old_a = a;
+        set_value(a, b);
+        set_value(b, old_a);
+    }
+
+    /**
+     * @brief Empties the undo log and the node records of a finished batch
+     */
+    void clear_batch();
+
 public:
     /**
      * @brief Default constructor
@@ -79,7 +155,7 @@ public:
 
     /**
      * @brief Destructor - deallocates all nodes
-     * @details Safely deletes all nodes to prevent memory leaks
+     * @details Safely deletes all nodes to prevent memory leaks; an open batch is rolled back first
      * @complexity O(n) time - O(1) memory
      */
     ~LinkedList();
@@ -111,7 +187,8 @@ public:
 
     /**
      * @brief Verifies the integrity of the data structure (debugging)
-     * @details Checks if head, tail, length, and node connections are consistent
+     * @details Checks if head, tail, length, and node connections are consistent.
+     *          Skipped while a batch is open; commit() and rollback() run it once
      */
     void debug_verify_data_integrity();
 
@@ -178,11 +255,12 @@ public:
     void remove_last_occurence(int key);
 
     /**
-     * @brief Finds the maximum value in the list using recursion
-     * @param head Starting node for recursion (default: nullptr)
-     * @param is_first_call Flag for initial call (default: true)
+     * @brief Finds the maximum value in the list
+     * @param head Node to start from when is_first_call is false (default: nullptr)
+     * @param is_first_call Start from the list head (default: true)
      * @return The maximum integer value in the list
-     * @complexity O(n) time - O(n) memory
+     * @details Iterative, so long lists cannot overflow the stack
+     * @complexity O(n) time - O(1) memory
      */
     int max(Node* head = nullptr, bool is_first_call = true);
 
@@ -245,6 +323,16 @@ public:
      */
     void remove_all_repeated_of_k(int k);
 
+    /**
+     * @brief Removes every node whose value satisfies a predicate
+     * @param pred Callable taking the node value and returning true to remove it
+     * @return Number of nodes removed
+     * @details Unlinks all matches in one traversal and reclaims them as one batch
+     * @complexity O(n) time - O(k) memory for k removed nodes
+     */
+    template <typename Predicate>
+    int erase_if(Predicate pred);
+
     ////////////////////////////////////////////////////////////
 
     /**
@@ -362,6 +450,29 @@ public:
      */
     int search_improved(int val);
 
+    /**
+     * @brief Searches for many values in a single pass over the list
+     * @param vals Values to search for
+     * @return 1-based position of each value's first occurrence, or -1 if not found
+     * @details All lookups share one traversal, so the list is walked once
+     *          instead of once per value; the walk stops when every value is found
+     * @complexity O(n + k) time - O(k) memory
+     */
+    vector<int> search_batch(const vector<int>& vals);
+
+    /**
+     * @brief Retrieves many positions in a single pass over the list
+     * @param positions 1-based positions, in any order
+     * @return The node at each position, or nullptr if out of range
+     * @complexity O(n + k log k) time - O(k) memory
+     */
+    vector<Node*> get_nth_batch(const vector<int>& positions);
+
+    /**
+     * @brief Gets the memory and operation counters (only with DS_ENABLE_STATS)
+     */
+    DS_STATS_ACCESSOR
+
     ////////////////////////////////////////////////////////////
 
     /**
@@ -413,4 +524,129 @@ public:
      * @complexity O(n) time - O(1) memory
      */
     void reverse_chains(int k);
+
+    ////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Opens a batch: the following mutations can be undone together
+     * @details Until commit() or rollback(), every head, tail, next, length and
+     *          data field the list overwrites is logged with its old value,
+     *          deleted nodes are kept instead of freed and the per-operation
+     *          integrity checks are skipped. Nothing is copied up front, so
+     *          the cost is proportional to what the batch changes.
+     *          Batches do not nest.
+     * @complexity O(1) time - O(w) memory for w writes in the batch
+     */
+    void begin_batch();
+
+    /**
+     * @brief Closes the batch and keeps its changes
+     * @details Frees the nodes deleted in the batch and verifies integrity once
+     * @complexity O(d) time for d deleted nodes
+     */
+    void commit();
+
+    /**
+     * @brief Closes the batch and restores the list as it was at begin_batch()
+     * @details Replays the undo log newest first, which relinks the deleted
+     *          nodes, then frees the nodes created in the batch. Lists passed to
+     *          insert_alternate() in the batch are restored too
+     * @complexity O(w) time for w writes in the batch
+     */
+    void rollback();
+
+    /**
+     * @brief Checks whether a batch is open
+     */
+    bool is_batch_open() const;
+
+    /**
+     * @class BatchGuard
+     * @brief Scoped batch that rolls back unless committed
+     * @details Makes a multi-step edit all-or-nothing, also when a step throws:
+     * @code
+     * {
+     *     LinkedList::BatchGuard batch(list);
+     *     list.swap_head_and_tail();
+     *     list.erase_if(pred); // may throw
+     *     batch.commit();
+     * } // rolled back here if commit() was not reached
+     * @endcode
+     */
+    class BatchGuard
+    {
+    private:
+        LinkedList& list;
+        bool committed = false;
+
+    public:
+        explicit BatchGuard(LinkedList& list) : list(list) { list.begin_batch(); }
+
+        BatchGuard(const BatchGuard&) = delete;
+        BatchGuard& operator=(const BatchGuard&) = delete;
+
+        ~BatchGuard()
+        {
+            if (!committed)
+                list.rollback();
+        }
+
+        void commit()
+        {
+            list.commit();
+            committed = true;
+        }
+    };
+
+#ifdef DS_HAS_COROUTINES
+    ////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Streams the values from head to tail (C++20)
+     * @details Lazy: combine with the pipeline:: stages of Generator.h to filter,
+     *          map, take or chunk without building a string or vector.
+     *          Do not modify the list while the generator is suspended mid-traversal.
+     * @complexity O(n) time - O(1) memory
+     */
+    Generator<int> values() const;
+
+    /**
+     * @brief Streams the nodes from head to tail (C++20)
+     * @details The next node is read before a node is handed out
+     * @complexity O(n) time - O(1) memory
+     */
+    Generator<Node*> nodes() const;
+#endif
 };
+
+// ===== Template member definitions =====
+template <typename Predicate>
+int LinkedList::erase_if(Predicate pred)
+{ // O(n) time - O(k) memory
+    DS_STATS_OP("erase_if");
+    vector<Node*> removed;
+    Node* prv = nullptr;
+    for (Node* cur = head; cur;)
+    {
+        DS_STATS_STEP();
+        Node* next = cur->next;
+        if (pred(cur->data))
+        {
+            if (prv)
+                set_link(prv->next, next);
+            else
+                set_link(head, next);
+            if (cur == tail)
+                set_link(tail, prv);
+            removed.push_back(cur);
+        }
+        else
+            prv = cur;
+        cur = next;
+    }
+
+    int count = (int)removed.size();
+    if (count)
+        release_batch(removed);
+    return count;
+}
@@ -1,5 +1,7 @@
 ﻿#include <iostream>
+#include <stdexcept>
 #include "SingleLinkedList.h"
+#include "PersistentList.h"
 #define el '\n'
 using namespace std;
 
@@ -161,6 +163,15 @@ void test_search_operations()
     assert(node && node->data == 40);
     cout << "get_nth_back(2): " << (node ? node->data : -1) << "\n";
 
+    // Test batched lookups (one traversal for all values)
+    list.insert_end(20);
+    assert(list.search_batch({ 50, 99, 20, 10, 20 }) == vector<int>({ 5, -1, 2, 1, 2 }));
+    assert(list.search_batch({}).empty());
+    vector<Node*> nodes = list.get_nth_batch({ 6, 0, 2, 7, 2, 1 });
+    assert(nodes[0]->data == 20 && !nodes[1] && nodes[2]->data == 20 && !nodes[3]);
+    assert(nodes[4] == nodes[2] && nodes[5]->data == 10);
+    assert(list.max() == 50 && list.max(list.get_nth(5), false) == 50 && list.max(nullptr, false) == INT_MIN);
+
     cout << "✓ Search operations passed\n";
 }
 
@@ -201,6 +212,21 @@ void test_duplicate_removal()
     list3.print();
     assert(list3.debug_to_string() == "2 4");
 
+    // Test erase_if (head, middle and tail matches)
+    LinkedList list4;
+    for (int i = 1; i <= 10; ++i) list4.insert_end(i);
+    int removed = list4.erase_if([](int data) { return data % 2 == 0 || data == 1; });
+    assert(removed == 6);
+    assert(list4.debug_to_string() == "3 5 7 9");
+    cout << "erase_if removed " << removed << " nodes\n";
+    list4.insert_end(11);
+    assert(list4.debug_to_string() == "3 5 7 9 11");
+    removed = list4.erase_if([](int data) { return data > 100; });
+    assert(removed == 0);
+    removed = list4.erase_if([](int) { return true; });
+    assert(removed == 5);
+    assert(list4.debug_to_string() == "");
+
     cout << "✓ Duplicate removal passed\n";
 }
 
@@ -367,6 +393,196 @@ void test_sorted_operations()
     cout << "✓ Sorted operations passed\n";
 }
 
+void test_batch_operations()
+{
+    cout << "\n=== Test Batch Operations ===\n";
+    LinkedList list;
+    for (int i = 1; i <= 6; i++)
+        list.insert_end(i);
+
+    // Rollback undoes relinking, inserts, deletes and value writes together
+    LinkedList digits;
+    digits.insert_end(9);
+    digits.insert_end(9);
+    list.begin_batch();
+    list.swap_head_and_tail();
+    list.odd_pos_even_pos();
+    list.reverse_chains(4);
+    list.insert_front(0);
+    list.delete_back();
+    list.remove_all_repeated_of_k(3);
+    list.swap_pairs();
+    list.add_num(digits);
+    assert(list.is_batch_open());
+    list.rollback();
+    assert(!list.is_batch_open());
+    assert(list.debug_to_string() == "1 2 3 4 5 6" && list.get_nth_back(1)->data == 6);
+    cout << "After rollback: ";
+    list.print();
+
+    // Commit keeps the changes and frees the deleted nodes
+    list.begin_batch();
+    list.reverse();
+    list.delete_front();
+    list.insert_end(9);
+    list.rotate_left(2);
+    list.commit();
+    assert(list.debug_to_string() == "3 2 1 9 5 4");
+    cout << "After commit: ";
+    list.print();
+
+    // A step that throws leaves the list as it was
+    try
+    {
+        LinkedList::BatchGuard batch(list);
+        list.delete_front();
+        list.erase_if([](int data) {
+            if (data == 9)
+                throw std::runtime_error("bad value");
+            return data % 2 == 1;
+        });
+        batch.commit();
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    assert(list.debug_to_string() == "3 2 1 9 5 4");
+
+    {
+        LinkedList::BatchGuard batch(list);
+        list.erase_if([](int data) { return data % 2 == 1; });
+        batch.commit();
+    }
+    assert(list.debug_to_string() == "2 4");
+
+    // Emptying the list and an unfinished batch at destruction
+    LinkedList other;
+    other.insert_end(7);
+    other.begin_batch();
+    other.delete_node_with_key(7);
+    other.insert_front(8);
+    other.insert_front(9);
+
+    cout << "✓ Batch operations passed\n";
+}
+
+void test_persistent_list()
+{
+    cout << "\n=== Test Persistent List ===\n";
+
+    // Old versions stay intact and share their nodes with new ones
+    PersistentList empty;
+    PersistentList v1 = empty.insert_front(3).insert_front(2);
+    PersistentList v2 = v1.insert_front(1);
+    PersistentList v3 = v2.delete_front();
+    assert(empty.is_empty() && v1.debug_to_string() == "2 3");
+    assert(v2.debug_to_string() == "1 2 3" && v2.get_length() == 3 && v2.front() == 1);
+    assert(v2.get_nth(2) == v1.get_nth(1));
+    assert(v3.get_nth(1) == v1.get_nth(1));
+    cout << "v1: "; v1.print();
+    cout << "v2: "; v2.print();
+
+    // Positional versions copy only the prefix
+    PersistentList v4 = v2.insert_at(3, 9);
+    assert(v4.debug_to_string() == "1 2 9 3" && v2.debug_to_string() == "1 2 3");
+    assert(v4.get_nth(4) == v2.get_nth(3));
+    PersistentList v5 = v4.delete_at(2);
+    assert(v5.debug_to_string() == "1 9 3" && v5.get_nth(2) == v4.get_nth(3));
+    assert(v4.delete_at(9).debug_to_string() == "1 2 9 3");
+
+    PersistentList v6 = v4.rotate_left(1);
+    assert(v6.debug_to_string() == "2 9 3 1" && v4.debug_to_string() == "1 2 9 3");
+    assert(v4.rotate_left(-1).debug_to_string() == "3 1 2 9");
+    assert(v4.rotate_left(8).debug_to_string() == "1 2 9 3");
+    v6.debug_verify_data_integrity();
+
+    // Snapshots survive the writer moving on, and long chains release iteratively
+    PersistentList current;
+    for (int i = 0; i < 200000; ++i)
+        current = current.insert_front(i);
+    PersistentList snapshot = current;
+    for (int i = 0; i < 1000; ++i)
+        current = current.delete_front();
+    assert(snapshot.get_length() == 200000 && snapshot.front() == 199999);
+    assert(current.get_length() == 199000 && current.get_nth(1) == snapshot.get_nth(1001));
+    current = PersistentList();
+    snapshot = PersistentList();
+    assert(snapshot.is_empty());
+
+    cout << "✓ Persistent list passed\n";
+}
+
+void test_streaming()
+{
+    cout << "\n=== Test Streaming ===\n";
+#ifdef DS_HAS_COROUTINES
+    LinkedList list;
+    for (int i = 1; i <= 10; ++i)
+        list.insert_end(i);
+
+    vector<int> seen;
+    for (int value : list.values())
+        seen.push_back(value);
+    assert(seen.size() == 10 && seen.front() == 1 && seen.back() == 10);
+
+    // Lazy pipeline: odd values, squared, first 3, in chunks of 2
+    vector<vector<int>> batches;
+    for (const vector<int>& batch : list.values()
+            | pipeline::filter([](int x) { return x % 2 == 1; })
+            | pipeline::map([](int x) { return x * x; })
+            | pipeline::take(3)
+            | pipeline::chunk(2))
+        batches.push_back(batch);
+    assert(batches == vector<vector<int>>({ { 1, 9 }, { 25 } }));
+
+    int sum = 0;
+    for (Node* node : list.nodes())
+        sum += node->data;
+    assert(sum == 55);
+
+    // An empty list and take(0) produce nothing (every value here is positive)
+    LinkedList empty;
+    sum = 0;
+    for (int value : empty.values() | pipeline::take(5))
+        sum += value;
+    for (int value : list.values() | pipeline::take(0))
+        sum += value;
+    assert(sum == 0);
+
+    cout << "✓ Streaming passed\n";
+#else
+    cout << "Streaming needs C++20 coroutines (skipped)\n";
+#endif
+}
+
+void test_statistics()
+{
+    cout << "\n=== Test Statistics ===\n";
+#ifdef DS_ENABLE_STATS
+    LinkedList list;
+    for (int i = 1; i <= 5; ++i)
+        list.insert_end(i);
+    list.delete_front();
+    list.search(5);
+
+    ContainerStats stats = list.get_stats();
+    assert(stats.live_nodes == 4 && stats.allocations == 5 && stats.frees == 1);
+    assert(stats.bytes == 4 * (long long)sizeof(Node));
+    assert(stats.operation("insert_end").calls == 5);
+    assert(stats.operation("search").calls == 1 && stats.operation("search").nodes_traversed > 0);
+
+    string json = stats.to_json();
+    assert(json.find("\"frees\":1") != string::npos);
+    assert(json.find("\"search\":{\"calls\":1") != string::npos);
+    cout << json << "\n";
+
+    cout << "✓ Statistics passed\n";
+#else
+    cout << "Statistics are disabled (build with DS_ENABLE_STATS to run this test)\n";
+#endif
+}
+
 void run_all_tests()
 {
     cout << "\n" << string(50, '=') << "\n";
@@ -386,6 +602,10 @@ void run_all_tests()
         test_edge_cases();
         test_comparison_operations();
         test_sorted_operations();
+        test_batch_operations();
+        test_persistent_list();
+        test_streaming();
+        test_statistics();
 
         cout << "\n" << string(50, '=') << "\n";
         cout << "🎉 ALL TESTS PASSED SUCCESSFULLY! 🎉\n";
@@ -13,7 +13,8 @@ void ColumnLinkedList::link(ColumnNode* first, ColumnNode* second) {
 
 ColumnNode* ColumnLinkedList::embed_after(ColumnNode* node_befor, int data, int col)
 {
-	ColumnNode* middle = new ColumnNode(data, col);
+	ColumnNode* middle = arena->create(data, col);
+	DS_STATS_ALLOC(sizeof(ColumnNode));
 	++length;
 
 	ColumnNode* node_after = node_befor->next;
@@ -29,9 +30,12 @@ ColumnNode* ColumnLinkedList::embed_after(ColumnNode* node_befor, int data, int
 
 ColumnNode* ColumnLinkedList::get_col(int col, bool is_create_if_missing)
 {
+	DS_STATS_OP("get_col");
 	ColumnNode* prev_col = head;
-	while (prev_col->next && prev_col->next->column < col)
+	while (prev_col->next && prev_col->next->column < col) {
+		DS_STATS_STEP();
 		prev_col = prev_col->next; // to get node with col-1
+	}
 
 	bool found = prev_col->next && prev_col->next->column == col;
 
@@ -44,13 +48,28 @@ ColumnNode* ColumnLinkedList::get_col(int col, bool is_create_if_missing)
 	return embed_after(prev_col, 0, col);
 }
 
-ColumnLinkedList::ColumnLinkedList(int cols) : cols(cols)
+ColumnLinkedList::ColumnLinkedList(int cols, NodeArena<ColumnNode>* arena) : arena(arena), cols(cols)
 {
+	if (!arena) {
+		own_arena.reset(new NodeArena<ColumnNode>());
+		this->arena = own_arena.get();
+	}
 	// Sentinel_node
-	tail = head = new ColumnNode(0, -1);
+	tail = head = this->arena->create(0, -1);
+	DS_STATS_ALLOC(sizeof(ColumnNode));
 	++length;
 }
 
+ColumnLinkedList::~ColumnLinkedList()
+{
+	while (head) {
+		ColumnNode* next = head->next;
+		DS_STATS_FREE(sizeof(ColumnNode));
+		arena->destroy(head);
+		head = next;
+	}
+}
+
 void ColumnLinkedList::print_row()
 {
 	ColumnNode* cur = head->next;
@@ -75,11 +94,13 @@ void ColumnLinkedList::print_row_nonzero()
 
 void ColumnLinkedList::set_value(int data, int col) 
 {
+	DS_STATS_OP("set_value");
 	get_col(col, true)->data = data;
 }
 
 int ColumnLinkedList::get_value(int col) 
 {
+	DS_STATS_OP("get_value");
 	ColumnNode* node = get_col(col, false);
 	if (!node)
 		return 0;
@@ -88,6 +109,7 @@ int ColumnLinkedList::get_value(int col)
 
 void ColumnLinkedList::add(ColumnLinkedList& other)
 {
+	DS_STATS_OP("add");
 	assert(cols == other.cols);
 
 	// Iterate on the other first, and add it to the current one
@@ -96,4 +118,13 @@ void ColumnLinkedList::add(ColumnLinkedList& other)
 		this_col->data += other_cur->data;
 	}
 	// ** We can make this function more efficient, but let's keep simple
-}
\ No newline at end of file
+}
+
+#ifdef DS_HAS_COROUTINES
+Generator<std::pair<int, int>> ColumnLinkedList::nonzeros() const
+{
+	for (ColumnNode* cur = head->next; cur; cur = cur->next)
+		if (cur->data != 0)
+			co_yield std::make_pair(cur->column, cur->data);
+}
+#endif
@@ -1,14 +1,24 @@
 #pragma once
 
 #include "ColumnNode.h"
+#include "../Common/ContainerStats.h"
+#include "../Common/NodeArena.h"
+#include "../Common/Generator.h"
+#include <memory>
+#include <utility>
 
 class ColumnLinkedList {
 private:
+	// Cells come from the arena of the owning matrix, or from an own one for a standalone row
+	std::unique_ptr<NodeArena<ColumnNode>> own_arena;
+	NodeArena<ColumnNode>* arena{};
 	ColumnNode* head{};
 	ColumnNode* tail{};
 	int length = 0;
 	int cols{};	// Total number of columns
 
+	DS_STATS_MEMBER
+
 	void link(ColumnNode* first, ColumnNode* second);
 
 	ColumnNode* embed_after(ColumnNode* node_befor, int data, int col);
@@ -17,7 +27,14 @@ private:
 
 public:
 
-	ColumnLinkedList(int cols);
+	// arena: where the cells are allocated (nullptr: an arena of its own)
+	ColumnLinkedList(int cols, NodeArena<ColumnNode>* arena = nullptr);
+
+	~ColumnLinkedList();
+
+	// Disable copy operations to prevent shallow copying issues
+	ColumnLinkedList(const ColumnLinkedList&) = delete;
+	ColumnLinkedList& operator=(const ColumnLinkedList&) = delete;
 
 	void print_row();
 	void print_row_nonzero();
@@ -27,4 +44,11 @@ public:
 	int get_value(int col);
 
 	void add(ColumnLinkedList& other);
+
+	DS_STATS_ACCESSOR
+
+#ifdef DS_HAS_COROUTINES
+	// Streams (column, value) of the nonzero cells in column order (C++20)
+	Generator<std::pair<int, int>> nonzeros() const;
+#endif
 };
\ No newline at end of file
@@ -9,5 +9,5 @@ struct RowNode
 	RowNode* next{};
 	RowNode* prev{};
 
-	RowNode(int row, int cols) : row(row), col_list(cols) {}
+	RowNode(int row, int cols, NodeArena<ColumnNode>* cells) : row(row), col_list(cols, cells) {}
 };
\ No newline at end of file
@@ -37,6 +37,28 @@ void test_sparse() {
 	mat.print_matrix_nonzero();
 }
 
+#ifdef DS_HAS_COROUTINES
+void test_nonzeros() {
+	SparseMatrix mat(10, 10);
+	mat.set_value(5, 3, 5);
+	mat.set_value(2, 3, 2);
+	mat.set_value(0, 3, 2);
+	mat.set_value(6, 5, 6);
+	mat.set_value(1, 7, 1);
+
+	for (const MatrixEntry& e : mat.nonzeros())
+		cout << "(" << e.row << "," << e.col << ")=" << e.value << " ";
+	cout << "\n";
+	// (3,5)=5 (5,6)=6 (7,1)=1
+
+	// First cell above 1, without building any buffer
+	for (const MatrixEntry& e : mat.nonzeros()
+			| pipeline::filter([](const MatrixEntry& e) { return e.value > 1; })
+			| pipeline::take(1))
+		cout << "first cell > 1: (" << e.row << "," << e.col << ")\n";
+	// first cell > 1: (3,5)
+}
+#endif
 
 int main() {
 	cout << "*** Starting test cases *** \n\n\n";
@@ -47,6 +69,11 @@ int main() {
 	cout << "\n*** Start testing Sparse Matrix ***\n\n";
 	test_sparse();
 
+#ifdef DS_HAS_COROUTINES
+	cout << "\n*** Start testing nonzeros streaming ***\n\n";
+	test_nonzeros();
+#endif
+
 	cout << "\n\n*** End of test cases ***\n\n";
 	cout << "No RTA\n";
 	return 0;
@@ -12,7 +12,8 @@ void SparseMatrix::link(RowNode* first, RowNode* second)
 
 RowNode* SparseMatrix::embed_after(RowNode* node_before, int row)
 {
-	RowNode* middle = new RowNode(row, cols);
+	RowNode* middle = row_arena.create(row, cols, &cell_arena);
+	DS_STATS_ALLOC(sizeof(RowNode));
 	++length;
 
 	RowNode* node_after = node_before->next;
@@ -29,10 +30,13 @@ RowNode* SparseMatrix::embed_after(RowNode* node_before, int row)
 RowNode* SparseMatrix::get_row(int row, bool is_create_if_missing)
 {
 	// Similar logic to insert_sorted
+	DS_STATS_OP("get_row");
 	RowNode* prev_row = head;
 	// Find the node with row-1
-	while (prev_row->next && prev_row->next->row < row)
+	while (prev_row->next && prev_row->next->row < row) {
+		DS_STATS_STEP();
 		prev_row = prev_row->next;
+	}
 
 	bool found = prev_row->next && prev_row->next->row == row;
 
@@ -47,12 +51,25 @@ RowNode* SparseMatrix::get_row(int row, bool is_create_if_missing)
 
 SparseMatrix::SparseMatrix(int rows, int cols) : rows(rows), cols(cols)
 {
-	tail = head = new RowNode(-1, cols);
+	tail = head = row_arena.create(-1, cols, &cell_arena);
+	DS_STATS_ALLOC(sizeof(RowNode));
 	++length;
 }
 
+SparseMatrix::~SparseMatrix()
+{
+	// Each row gives its cells back to cell_arena, which outlives the rows
+	while (head) {
+		RowNode* next = head->next;
+		DS_STATS_FREE(sizeof(RowNode));
+		row_arena.destroy(head);
+		head = next;
+	}
+}
+
 void SparseMatrix::set_value(int data, int row, int col)
 {
+	DS_STATS_OP("set_value");
 	assert(0 <= row && row < rows);
 	assert(0 <= col && col < cols);
 
@@ -62,6 +79,7 @@ void SparseMatrix::set_value(int data, int row, int col)
 
 int SparseMatrix::get_value(int row, int col)
 {
+	DS_STATS_OP("get_value");
 	assert(0 <= row && row < rows);
 	assert(0 <= col && col < cols);
 
@@ -99,6 +117,7 @@ void SparseMatrix::print_matrix_nonzero()
 
 void SparseMatrix::add(SparseMatrix& other)
 {
+	DS_STATS_OP("add");
 	assert(rows == other.rows && cols == other.cols);
 	// Iterate on the other first, and add it to the current one
 	for (RowNode* other_cur = other.head->next; other_cur; other_cur = other_cur->next) {
@@ -107,3 +126,22 @@ void SparseMatrix::add(SparseMatrix& other)
 	}
 	// ** We can make this function more efficient, but let's keep simple
 }
+
+#ifdef DS_ENABLE_STATS
+ContainerStats SparseMatrix::get_stats() const
+{
+	ContainerStats total = stats;
+	for (RowNode* cur = head; cur; cur = cur->next)
+		total += cur->col_list.get_stats();
+	return total;
+}
+#endif
+
+#ifdef DS_HAS_COROUTINES
+Generator<MatrixEntry> SparseMatrix::nonzeros() const
+{
+	for (RowNode* cur = head->next; cur; cur = cur->next)
+		for (const auto& cell : cur->col_list.nonzeros())
+			co_yield MatrixEntry{ cur->row, cell.first, cell.second };
+}
+#endif
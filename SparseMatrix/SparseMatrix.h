@@ -1,14 +1,28 @@
 #pragma once
 #include "RowNode.h"
+#include "../Common/ContainerStats.h"
+#include "../Common/Generator.h"
+
+// One nonzero cell, as streamed by SparseMatrix::nonzeros()
+struct MatrixEntry
+{
+	int row{};
+	int col{};
+	int value{};
+};
 
 
 class SparseMatrix {
 private:
+	// One arena for the rows and one shared by the cells of every row
+	NodeArena<RowNode> row_arena;
+	NodeArena<ColumnNode> cell_arena;
 	RowNode* head{};
 	RowNode* tail{};
 	int length = 0;
 	int rows{};
 	int cols{};
+	DS_STATS_MEMBER
 
 	void link(RowNode* first, RowNode* second);
 
@@ -19,6 +33,12 @@ private:
 public:
 	SparseMatrix(int rows, int cols);
 
+	~SparseMatrix();
+
+	// Disable copy operations to prevent shallow copying issues
+	SparseMatrix(const SparseMatrix&) = delete;
+	SparseMatrix& operator=(const SparseMatrix&) = delete;
+
 	void set_value(int data, int row, int col);
 
 	int get_value(int row, int col);
@@ -28,4 +48,14 @@ public:
 	void print_matrix_nonzero();
 
 	void add(SparseMatrix& other);
+
+#ifdef DS_ENABLE_STATS
+	// Row nodes of the matrix plus the column nodes of every row
+	ContainerStats get_stats() const;
+#endif
+
+#ifdef DS_HAS_COROUTINES
+	// Streams the nonzero cells row by row, each row in column order (C++20)
+	Generator<MatrixEntry> nonzeros() const;
+#endif
 };
\ No newline at end of file
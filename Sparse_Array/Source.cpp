@@ -23,6 +23,24 @@ void test_index() {
 	array.add(array2);
 	array.print_array();
 	// 0 0 20 0 41 50 4 73 0 0
+
+#ifdef DS_HAS_COROUTINES
+	// Values only, in batches of 3
+	for (const vector<int>& batch : array.nonzeros()
+			| pipeline::map([](const pair<int, int>& e) { return e.second; })
+			| pipeline::chunk(3)) {
+		for (int value : batch)
+			cout << value << ' ';
+		cout << "| ";
+	}
+	cout << "\n";
+	// 20 1 50 | 4 3 |
+
+	for (const auto& element : array.nonzeros())
+		cout << element.first << ":" << element.second << " ";
+	cout << "\n";
+	// 2:20 4:1 5:50 6:4 7:3
+#endif
 }
 
 int main() {
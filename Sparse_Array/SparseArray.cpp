@@ -14,7 +14,8 @@ void ArrayLinkedList::link(ArrayNode* first, ArrayNode* second)
 
 ArrayNode* ArrayLinkedList::embed_after(ArrayNode* node_before, int data, int index)
 {
-	ArrayNode* md = new ArrayNode(data, index);
+	ArrayNode* md = arena.create(data, index);
+	DS_STATS_ALLOC(sizeof(ArrayNode));
 	++length;
 
 	ArrayNode* node_after = node_before->next;
@@ -30,10 +31,13 @@ ArrayNode* ArrayLinkedList::embed_after(ArrayNode* node_before, int data, int in
 
 ArrayNode* ArrayLinkedList::get_index(int index, bool is_create_if_missing)
 {
+	DS_STATS_OP("get_index");
 	ArrayNode* prev_index = head;
 
-	while (prev_index->next && prev_index->next->index < index)
+	while (prev_index->next && prev_index->next->index < index) {
+		DS_STATS_STEP();
 		prev_index = prev_index->next;
+	}
 
 	bool found = prev_index->next && prev_index->next->index == index;
 
@@ -49,10 +53,21 @@ ArrayNode* ArrayLinkedList::get_index(int index, bool is_create_if_missing)
 ArrayLinkedList::ArrayLinkedList(int array_length): array_length(array_length)
 {
 	//Sentinel_node
-	tail = head = new ArrayNode(0, -1);
+	tail = head = arena.create(0, -1);
+	DS_STATS_ALLOC(sizeof(ArrayNode));
 	++length;
 }
 
+ArrayLinkedList::~ArrayLinkedList()
+{
+	while (head) {
+		ArrayNode* next = head->next;
+		DS_STATS_FREE(sizeof(ArrayNode));
+		arena.destroy(head);
+		head = next;
+	}
+}
+
 void ArrayLinkedList::print_array()
 {
 	ArrayNode* cur = head->next;
@@ -76,11 +91,13 @@ void ArrayLinkedList::print_array_nonzero()
 
 void ArrayLinkedList::set_value(int data, int index)
 {
+	DS_STATS_OP("set_value");
 	get_index(index, true)->data = data;
 }
 
 int ArrayLinkedList::get_value(int index)
 {
+	DS_STATS_OP("get_value");
 	ArrayNode* node = get_index(index, false);
 
 	if (!node)
@@ -91,6 +108,7 @@ int ArrayLinkedList::get_value(int index)
 
 void ArrayLinkedList::add(ArrayLinkedList& other)
 {
+	DS_STATS_OP("add");
 	assert(array_length == other.array_length);
 
 	for (ArrayNode* other_cur = other.head->next; other_cur; other_cur = other_cur->next) {
@@ -102,3 +120,11 @@ void ArrayLinkedList::add(ArrayLinkedList& other)
 
 }
 
+#ifdef DS_HAS_COROUTINES
+Generator<std::pair<int, int>> ArrayLinkedList::nonzeros() const
+{
+	for (ArrayNode* cur = head->next; cur; cur = cur->next)
+		if (cur->data != 0)
+			co_yield std::make_pair(cur->index, cur->data);
+}
+#endif
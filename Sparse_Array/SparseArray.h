@@ -1,14 +1,21 @@
 #pragma once
 
 #include "ArrayNode.h"
+#include "../Common/ContainerStats.h"
+#include "../Common/NodeArena.h"
+#include "../Common/Generator.h"
+#include <utility>
 
 class ArrayLinkedList {
 private:
+	NodeArena<ArrayNode> arena;	// every node, sentinel included, lives in these slabs
 	ArrayNode* head{};
 	ArrayNode* tail{};
 	int length = 0;			// total number of nodes
 	int array_length = 0;	// total number of array elements
 
+	DS_STATS_MEMBER
+
 	void link(ArrayNode* first, ArrayNode* second);
 
 	ArrayNode* embed_after(ArrayNode* node_before, int data, int index);
@@ -19,6 +26,12 @@ public:
 
 	ArrayLinkedList(int array_length);
 
+	~ArrayLinkedList();
+
+	// Disable copy operations to prevent shallow copying issues
+	ArrayLinkedList(const ArrayLinkedList&) = delete;
+	ArrayLinkedList& operator=(const ArrayLinkedList&) = delete;
+
 	void print_array();
 
 	void print_array_nonzero();
@@ -29,4 +42,11 @@ public:
 
 	void add(ArrayLinkedList& other);
 
+	DS_STATS_ACCESSOR
+
+#ifdef DS_HAS_COROUTINES
+	// Streams (index, value) of the nonzero elements in index order, O(1) memory (C++20)
+	Generator<std::pair<int, int>> nonzeros() const;
+#endif
+
 };
\ No newline at end of file
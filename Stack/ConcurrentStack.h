@@ -0,0 +1,249 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/// <summary>
+/// Lock-free stack for many threads (a Treiber stack), linked like Stack04
+///
+/// push and try_pop swing the head with one compare-and-swap. Nodes are
+/// addressed by 32-bit indexes into a pool instead of pointers, so the head
+/// fits in 64 bits together with a 32-bit tag that every successful swap
+/// increments. A thread that read the head, was delayed while the node was
+/// popped and pushed again, and then tries its swap sees a different tag
+/// and retries: the ABA problem cannot corrupt the list. Popped nodes go to
+/// a free list (another tagged stack) and are reused, never freed, so a
+/// delayed reader never touches released memory.
+///
+/// When a swap fails because of contention, the thread visits a random slot
+/// of an elimination array before retrying: a push parks its node there for
+/// a short while, and a pop that finds a parked node takes it. Such a pair
+/// cancels out without touching the head, so under heavy push/pop traffic
+/// throughput grows with the number of threads instead of collapsing on
+/// the one contended cache line.
+///
+/// Pool memory grows in chunks that double in size and is released by the
+/// destructor; it is not returned while the stack lives.
+/// </summary>
+template <typename T>
+class ConcurrentStack {
+private:
+	struct Node
+	{
+		std::atomic<std::uint32_t> next{};	///< Index of the node below (0 if none)
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* value() { return reinterpret_cast<T*>(storage); }
+	};
+
+	// Chunk k holds first_chunk << k nodes; index 0 means "no node"
+	static const int first_chunk_bits = 6;
+	static const int max_chunks = 25;
+
+	// Elimination slot: 0 empty, 1 taken by a pop, index + 1 while a push waits there
+	struct Slot
+	{
+		std::atomic<std::uint32_t> state{};
+		char padding[64 - sizeof(std::atomic<std::uint32_t>)];	// one slot per cache line
+	};
+	static const std::uint32_t taken = 1;
+	static const int elimination_slots = 16;
+	static const int elimination_spins = 128;
+
+	std::atomic<Node*> chunks[max_chunks];
+	std::atomic<std::uint32_t> next_unused{ 1 };
+	std::atomic<std::uint64_t> head{};		// tag << 32 | index of the top node
+	std::atomic<std::uint64_t> free_head{};	// same, for the free nodes
+	Slot slots[elimination_slots];
+	std::atomic<long long> eliminations{};
+
+	static std::uint64_t tagged(std::uint64_t old_top, std::uint32_t index) {
+		return ((old_top >> 32) + 1) << 32 | index;
+	}
+
+	static int floor_log2(std::uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+		return 31 - __builtin_clz(x);
+#else
+		int bits = 0;
+		while (x >>= 1)
+			++bits;
+		return bits;
+#endif
+	}
+
+	// Chunk and offset of a node index (index >= 1)
+	static void locate(std::uint32_t index, int& chunk, std::uint32_t& offset) {
+		std::uint32_t slot = index - 1 + (1u << first_chunk_bits);
+		chunk = floor_log2(slot) - first_chunk_bits;
+		offset = slot - (1u << (chunk + first_chunk_bits));
+	}
+
+	Node& node(std::uint32_t index) {
+		int chunk;
+		std::uint32_t offset;
+		locate(index, chunk, offset);
+		return chunks[chunk].load(std::memory_order_acquire)[offset];
+	}
+
+	std::uint32_t allocate_node() {
+		// Reuse a popped node first
+		std::uint64_t top = free_head.load(std::memory_order_acquire);
+		while ((std::uint32_t)top) {
+			std::uint32_t index = (std::uint32_t)top;
+			std::uint32_t below = node(index).next.load(std::memory_order_relaxed);
+			if (free_head.compare_exchange_weak(top, tagged(top, below), std::memory_order_acquire, std::memory_order_acquire))
+				return index;
+		}
+
+		std::uint32_t index = next_unused.fetch_add(1, std::memory_order_relaxed);
+		int chunk;
+		std::uint32_t offset;
+		locate(index, chunk, offset);
+		assert(chunk < max_chunks);
+		if (!chunks[chunk].load(std::memory_order_acquire)) {
+			// Threads that need the same new chunk race to install it; the losers drop theirs
+			Node* fresh = new Node[(std::size_t)1 << (chunk + first_chunk_bits)];
+			Node* expected = nullptr;
+			if (!chunks[chunk].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+				delete[] fresh;
+		}
+		return index;
+	}
+
+	void free_node(std::uint32_t index) {
+		std::uint64_t top = free_head.load(std::memory_order_relaxed);
+		do
+			node(index).next.store((std::uint32_t)top, std::memory_order_relaxed);
+		while (!free_head.compare_exchange_weak(top, tagged(top, index), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// Moves the value out of a node this thread owns and recycles the node
+	void take(std::uint32_t index, T& out) {
+		T* value = node(index).value();
+		out = std::move(*value);
+		value->~T();
+		free_node(index);
+	}
+
+	static unsigned random_slot() {
+		// xorshift per thread, seeded from the thread's own address
+		static thread_local std::uint32_t state = 0;
+		if (!state)
+			state = (std::uint32_t)(std::uintptr_t)&state | 1;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state % elimination_slots;
+	}
+
+	bool try_eliminate_push(std::uint32_t index) {
+		Slot& slot = slots[random_slot()];
+		std::uint32_t expected = 0;
+		if (!slot.state.compare_exchange_strong(expected, index + 1, std::memory_order_release, std::memory_order_relaxed))
+			return false;
+
+		for (int spin = 0; spin < elimination_spins; ++spin) {
+			if (slot.state.load(std::memory_order_acquire) == taken) {
+				slot.state.store(0, std::memory_order_release);
+				return true;
+			}
+		}
+
+		// Withdraw the offer, unless a pop takes it at the last moment
+		expected = index + 1;
+		if (slot.state.compare_exchange_strong(expected, 0, std::memory_order_acq_rel))
+			return false;
+		slot.state.store(0, std::memory_order_release);
+		return true;
+	}
+
+	bool try_eliminate_pop(T& out) {
+		Slot& slot = slots[random_slot()];
+		std::uint32_t offer = slot.state.load(std::memory_order_acquire);
+		if (offer <= taken || !slot.state.compare_exchange_strong(offer, taken, std::memory_order_acq_rel))
+			return false;
+
+		eliminations.fetch_add(1, std::memory_order_relaxed);
+		take(offer - 1, out);
+		return true;
+	}
+
+public:
+	ConcurrentStack() {
+		for (std::atomic<Node*>& chunk : chunks)
+			chunk.store(nullptr, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Destroys the remaining values and the pool (no other thread may use the stack)
+	/// </summary>
+	~ConcurrentStack() {
+		for (std::uint32_t index = (std::uint32_t)head.load(); index;) {
+			Node& top = node(index);
+			top.value()->~T();
+			index = top.next.load();
+		}
+		for (std::atomic<Node*>& chunk : chunks)
+			delete[] chunk.load();
+	}
+
+	// Disable copy operations to prevent shallow copying issues
+	ConcurrentStack(const ConcurrentStack&) = delete;
+	ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+	/// <summary>
+	/// Snapshot: the answer may be stale by the time the caller acts on it
+	/// </summary>
+	bool is_empty() const {
+		return (std::uint32_t)head.load(std::memory_order_acquire) == 0;
+	}
+
+	void push(T item) {
+		std::uint32_t index = allocate_node();
+		Node& item_node = node(index);
+		new (item_node.storage) T(std::move(item));
+
+		std::uint64_t top = head.load(std::memory_order_relaxed);
+		while (true) {
+			item_node.next.store((std::uint32_t)top, std::memory_order_relaxed);
+			if (head.compare_exchange_weak(top, tagged(top, index), std::memory_order_release, std::memory_order_relaxed))
+				return;
+			if (try_eliminate_push(index))
+				return;
+			top = head.load(std::memory_order_relaxed);
+		}
+	}
+
+	/// <summary>
+	/// Moves the top into out; false if the stack was empty
+	/// </summary>
+	bool try_pop(T& out) {
+		std::uint64_t top = head.load(std::memory_order_acquire);
+		while (true) {
+			std::uint32_t index = (std::uint32_t)top;
+			if (!index)
+				return false;
+			// The node may be popped and reused meanwhile; then the tag differs and the swap fails
+			std::uint32_t below = node(index).next.load(std::memory_order_relaxed);
+			if (head.compare_exchange_weak(top, tagged(top, below), std::memory_order_acquire, std::memory_order_acquire)) {
+				take(index, out);
+				return true;
+			}
+			if (try_eliminate_pop(out))
+				return true;
+			top = head.load(std::memory_order_acquire);
+		}
+	}
+
+	/// <summary>
+	/// Number of push/pop pairs that met in the elimination array
+	/// </summary>
+	long long eliminated_pairs() const {
+		return eliminations.load(std::memory_order_relaxed);
+	}
+};
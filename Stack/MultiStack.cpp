@@ -0,0 +1,152 @@
+#include "MultiStack.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#define el '\n'
+using std::cout;
+
+MultiStack::MultiStack(int stacks, int arr_size) :
+	arr_size(arr_size), stacks(stacks),
+	base(stacks + 1), top(stacks), old_depth(stacks), depths(stacks) {
+	assert(stacks >= 1 && arr_size >= 0);
+	arr = new int[arr_size];
+	DS_STATS_ALLOC(sizeof(int) * arr_size);
+
+	for (int j = 0; j <= stacks; ++j)
+		base[j] = (int)((long long)arr_size * j / stacks);
+	for (int j = 0; j < stacks; ++j)
+		top[j] = base[j];
+}
+
+MultiStack::~MultiStack() {
+	delete[] arr;
+	DS_STATS_FREE(sizeof(int) * arr_size);
+}
+
+int MultiStack::index(int id) const {
+	assert(1 <= id && id <= stacks);
+	return id - 1;
+}
+
+int MultiStack::stack_count() const {
+	return stacks;
+}
+
+bool MultiStack::is_empty(int id) const {
+	int j = index(id);
+	return top[j] == base[j];
+}
+
+bool MultiStack::is_full() const {
+	int used = 0;
+	for (int j = 0; j < stacks; ++j)
+		used += top[j] - base[j];
+	return used == arr_size;
+}
+
+int MultiStack::size(int id) const {
+	int j = index(id);
+	return top[j] - base[j];
+}
+
+bool MultiStack::reallocate(int j) {
+	DS_STATS_OP("reallocate");
+	// Count the pending push as already done, so stack j is sure to get a slot
+	int used = 1;
+	long long growth = 1;
+	std::vector<int> depth(stacks), grew(stacks);
+	for (int i = 0; i < stacks; ++i) {
+		depth[i] = top[i] - base[i];
+		grew[i] = depth[i] > old_depth[i] ? depth[i] - old_depth[i] : 0;
+		used += depth[i];
+		growth += grew[i];
+	}
+	++grew[j];
+	int free_slots = arr_size - used;
+	if (free_slots < 0)
+		return false;
+
+	// 10% shared equally, 90% in proportion to the growth since the last move
+	double equal_share = 0.1 * free_slots / stacks;
+	double growth_share = 0.9 * free_slots / growth;
+
+	std::vector<int> new_base(stacks + 1);
+	new_base[0] = 0;
+	new_base[stacks] = arr_size;
+	double sigma = 0;
+	for (int i = 1; i < stacks; ++i) {
+		double tau = sigma + equal_share + grew[i - 1] * growth_share;
+		new_base[i] = new_base[i - 1] + depth[i - 1] + (i - 1 == j) + (int)tau - (int)sigma;
+		sigma = tau;
+	}
+
+	auto move_stack = [&](int i) {
+		std::memmove(arr + new_base[i], arr + base[i], sizeof(int) * depth[i]);
+		base[i] = new_base[i];
+		top[i] = base[i] + depth[i];
+	};
+
+	// Stacks moving down go first in increasing order, then the ones moving up
+	// in decreasing order, so no stack is overwritten before it has moved
+	for (int i = 1; i < stacks; ++i)
+		if (new_base[i] < base[i])
+			move_stack(i);
+	for (int i = stacks - 1; i >= 1; --i)
+		if (new_base[i] > base[i])
+			move_stack(i);
+
+	old_depth = depth;
+	++old_depth[j];	// the push that triggered the move
+	++moves;
+	return true;
+}
+
+bool MultiStack::push(int id, int item) {
+	DS_STATS_OP("push");
+	int j = index(id);
+	if (top[j] == base[j + 1] && !reallocate(j))
+		return false;
+
+	arr[top[j]++] = item;
+
+	StackDepth& d = depths[j];
+	++d.pushes;
+	if (top[j] - base[j] > d.max_depth)
+		d.max_depth = top[j] - base[j];
+	return true;
+}
+
+int MultiStack::pop(int id) {
+	DS_STATS_OP("pop");
+	assert(!is_empty(id));
+	int j = index(id);
+	++depths[j].pops;
+	return arr[--top[j]];
+}
+
+int MultiStack::peek(int id) const {
+	assert(!is_empty(id));
+	int j = index(id);
+	return arr[top[j] - 1];
+}
+
+StackDepth MultiStack::depth_stats(int id) const {
+	int j = index(id);
+	StackDepth d = depths[j];
+	d.depth = top[j] - base[j];
+	d.capacity = base[j + 1] - base[j];
+	return d;
+}
+
+int MultiStack::boundary_moves() const {
+	return moves;
+}
+
+void MultiStack::display() const {
+	for (int j = 0; j < stacks; ++j) {
+		cout << j + 1 << ": ";
+		for (int i = top[j] - 1; i >= base[j]; i--)
+			cout << arr[i] << ' ';
+		cout << el;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include "../Common/ContainerStats.h"
+
+/// <summary>
+/// Depth statistics of one stack of a MultiStack
+/// </summary>
+struct StackDepth
+{
+	int depth{};			///< Elements now
+	int max_depth{};		///< Deepest the stack has been
+	int capacity{};			///< Slots now reserved for it in the arena
+	long long pushes{};
+	long long pops{};
+};
+
+/// <summary>
+/// Stack03 generalised: K stacks share one array
+///
+/// Stack id (1..K) owns the slots arr[base[id - 1] .. base[id] - 1] and fills
+/// them from the low end. When a push finds its region full while the
+/// arena still has free slots, the boundaries move (Garwick's algorithm):
+/// every stack keeps its elements, 10% of the free slots are shared equally
+/// and 90% go to the stacks that grew since the last move, in proportion to
+/// how much they grew. Stacks that are busy get the room, and a push only
+/// fails when the whole arena is full.
+///
+/// No stack allocates on its own: the arena is one allocation for all K.
+/// push, pop and peek are O(1); a boundary move is O(arr_size + K).
+/// </summary>
+class MultiStack {
+private:
+	int* arr{};
+	int arr_size{};
+	int stacks{};
+	std::vector<int> base;		// base[j]: first slot of stack j + 1; base[stacks] == arr_size
+	std::vector<int> top;		// top[j]: one past the top of stack j + 1
+	std::vector<int> old_depth;	// depths after the last boundary move
+	std::vector<StackDepth> depths;
+	int moves{};
+	DS_STATS_MEMBER
+
+	int index(int id) const;
+
+	/// <summary>
+	/// Moves the boundaries so that stack j gets one more slot; false if the arena is full
+	/// </summary>
+	bool reallocate(int j);
+
+public:
+	/// <summary>
+	/// K empty stacks sharing an array of arr_size slots, split evenly at first
+	/// </summary>
+	MultiStack(int stacks, int arr_size);
+
+	~MultiStack();
+
+	// Disable copy operations to prevent shallow copying issues
+	MultiStack(const MultiStack&) = delete;
+	MultiStack& operator=(const MultiStack&) = delete;
+
+	int stack_count() const;
+
+	bool is_empty(int id) const;
+
+	/// <summary>
+	/// True when every slot of the arena is in use
+	/// </summary>
+	bool is_full() const;
+
+	int size(int id) const;
+
+	/// <summary>
+	/// Pushes on stack id; false (nothing pushed) if the whole arena is full
+	/// </summary>
+	bool push(int id, int item);
+
+	int pop(int id);
+
+	int peek(int id) const;
+
+	/// <summary>
+	/// Depth, peak depth, reserved slots and push/pop counts of stack id
+	/// </summary>
+	StackDepth depth_stats(int id) const;
+
+	/// <summary>
+	/// Number of times the boundaries were moved
+	/// </summary>
+	int boundary_moves() const;
+
+	/// <summary>
+	/// One line per stack, top first
+	/// </summary>
+	void display() const;
+	DS_STATS_ACCESSOR
+};
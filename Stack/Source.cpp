@@ -2,14 +2,33 @@
 #include "Stack02.h"
 #include "Stack03.h"
 #include "Stack04.h"
+#include "MultiStack.h"
+#include "ConcurrentStack.h"
+#include "WorkStealingPool.h"
 #include <stack>
 #include <vector>
+#include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include <cstdlib>
 #define el '\n'
 using namespace std;
 //typedef int type;
 
 // Test Cases & Applications
 
+// Test check that stays on in Release builds, where NDEBUG turns assert off.
+// Keep side effects out of the condition anyway, so a failing run is easy to read.
+#define CHECK(condition) check((condition), #condition, __LINE__)
+void check(bool passed, const char* condition, int line) {
+	if (passed)
+		return;
+	cout << "Not Passed: " << condition << " (line " << line << ")\n";
+	exit(1);
+}
+
 
 string reverse_subwords(string line) {
 	line += ' ';
@@ -33,7 +52,7 @@ int reverse_num(int num) {
 	if (num == 0)
 		return 0;
 	
-	Stack s(32);
+	Stack<> s;
 
 	while (num)
 		s.push(num % 10), num /= 10;
@@ -69,7 +88,7 @@ bool is_valid_parentheses(string s){
 
 string remove_all_adjacent_dublicates(string s) {
 	int n = s.length();
-	Stack st(n);
+	Stack<> st;
 	for (int i = 0; i < n; ++i) {
 		if (st.is_empty() || s[st.peek()] != s[i]) 
 			st.push(i);
@@ -86,8 +105,7 @@ string remove_all_adjacent_dublicates(string s) {
 
 vector<int> asteroid_collision(vector<int>& asteroids) {
 	vector<int> ret;
-	int n = asteroids.size();
-	Stack result(n);
+	Stack<> result;
 	for (int asteroid : asteroids)
 	{
 		bool is_exploded = false;
@@ -197,7 +215,7 @@ int factorial_with_manual_stack(int n) {
 }
 
 int score_of_valid_parentheses(string s) {
-	Stack st(s.size());
+	Stack<> st;
 
 	st.push(0); // temp value to help us
 
@@ -222,7 +240,7 @@ int score_of_valid_parentheses(string s) {
 }
 
 int score_of_valid_parentheses_V1(string s) {
-	Stack st(s.size());
+	Stack<> st;
 
 	st.push(0); // temp value to help us
 
@@ -246,7 +264,7 @@ int score_of_valid_parentheses_V1(string s) {
 	return st.peek();
 }
 int score_of_valid_parentheses_V2(string s) {
-	Stack st(s.size());
+	Stack<> st;
 
 	int ind = 0;
 	for (char& c : s)
@@ -264,7 +282,7 @@ int score_of_valid_parentheses_V2(string s) {
 
 vector<int> next_greater_element(vector<int> nums) {
 	int n = nums.size();
-	Stack st(n);
+	Stack<> st;
 	vector<int> ans(n);
 
 	for (int i = n-1; i >= 0; i--)
@@ -456,7 +474,7 @@ void infix_to_postfix_tests() {
 void test_based_array_stack() {
 	cout << "\n\n***\ttest based array stack\t***\n\n";
 
-	Stack stk(3);
+	Stack<> stk(3);
 	stk.push(10);
 	stk.push(20);
 	stk.push(30);
@@ -473,8 +491,416 @@ void test_based_array_stack() {
 		stk.pop();
 	} // 30 20 10
 }
+void test_reversed_array_stack() {
+	cout << "\n\n***\ttest reversed array stack\t***\n\n";
+
+	Stack02 stk(3);
+	bool pushed[4];
+	for (int i = 0; i < 4; ++i)
+		pushed[i] = stk.push(10 * (i + 1));
+	CHECK(pushed[0] && pushed[1] && pushed[2] && !pushed[3]);
+	CHECK(stk.data()[0] == 30 && stk.data()[2] == 10 && stk.size() == 3);
+	stk.display();	// 30 20 10
+	bool popped = stk.pop();
+	CHECK(popped && stk.peek() == 20 && stk.data()[0] == 20);
+	bool popped_second = stk.pop();
+	bool popped_last = stk.pop();
+	bool popped_empty = stk.pop();
+	CHECK(popped_second && popped_last && !popped_empty && stk.peek() == -1);
+
+	// Linear now: a deep stack no longer shifts on every push and pop
+	string deep = string(1 << 20, '(') + string(1 << 20, ')');
+	bool balanced = is_valid_parentheses(deep);
+	bool unbalanced = is_valid_parentheses(deep + "(");
+	CHECK(balanced && !unbalanced);
+	CHECK(reverse_subwords("abc de") == "cba ed ");
+
+	cout << "Passed\n";
+}
+void test_multi_stack() {
+	cout << "\n\n***\ttest multi stack\t***\n\n";
+
+	// 4 stacks in 40 slots: one busy stack borrows the room the others don't use
+	MultiStack stacks(4, 40);
+	stacks.push(1, 100);
+	stacks.push(4, 400);
+	bool all_pushed = true;
+	for (int i = 0; i < 30; ++i) {
+		bool pushed = stacks.push(2, i);
+		all_pushed = all_pushed && pushed;
+	}
+	CHECK(all_pushed);
+	CHECK(stacks.boundary_moves() > 0 && stacks.size(2) == 30);
+	CHECK(stacks.peek(1) == 100 && stacks.peek(4) == 400 && stacks.is_empty(3));
+	stacks.display();
+
+	StackDepth d = stacks.depth_stats(2);
+	CHECK(d.depth == 30 && d.max_depth == 30 && d.pushes == 30 && d.capacity >= 30);
+
+	// Fill the arena, then every push fails until something is popped
+	while (stacks.push(3, 3))
+		;
+	CHECK(stacks.is_full() && stacks.size(3) == 40 - 32);
+	bool pushed_when_full = stacks.push(1, 7);
+	int freed = stacks.pop(3);
+	bool pushed_after_pop = stacks.push(1, 7);
+	CHECK(!pushed_when_full && freed == 3 && pushed_after_pop);
+
+	// Elements keep their order across every boundary move
+	bool in_order = true;
+	for (int i = 29; i >= 0; --i) {
+		int value = stacks.pop(2);
+		in_order = in_order && value == i;
+	}
+	CHECK(in_order);
+	int seven = stacks.pop(1);
+	int hundred = stacks.pop(1);
+	int four_hundred = stacks.pop(4);
+	CHECK(seven == 7 && hundred == 100 && four_hundred == 400);
+	CHECK(stacks.depth_stats(2).pops == 30 && stacks.depth_stats(2).max_depth == 30);
+
+	cout << "Passed\n";
+}
+// Element whose move throws on demand, to check pushes that fail halfway
+struct ThrowingMove {
+	int value;
+	bool fail;
+	ThrowingMove(int value, bool fail) : value(value), fail(fail) {}
+	ThrowingMove(ThrowingMove&& other) : value(other.value), fail(other.fail) {
+		if (fail)
+			throw runtime_error("move failed");
+	}
+};
+
+void test_segmented_stack() {
+	cout << "\n\n***\ttest segmented stack\t***\n\n";
+
+	Stack04<int> stk;
+	CHECK(stk.is_empty() && stk.size() == 0);
+	for (int i = 0; i < 5000; ++i)	// several chunks
+		stk.push(i);
+	CHECK(stk.size() == 5000 && stk.peek() == 4999);
+	bool in_order = true;
+	for (int i = 4999; i >= 2000; --i) {
+		int value = stk.pop();
+		in_order = in_order && value == i;
+	}
+	CHECK(in_order);
+
+	while (!stk.is_empty())
+		stk.pop();
+
+	// Every pop below empties the only chunk and every push needs one again:
+	// the cached chunk serves them all
+	stk.push(-1);
+#ifdef DS_ENABLE_STATS
+	long long allocations = stk.get_stats().allocations;
+#endif
+	bool emptied_each_time = true;
+	for (int i = 0; i < 1000; ++i) {
+		int value = stk.pop();
+		emptied_each_time = emptied_each_time && value == i - 1 && stk.is_empty();
+		stk.push(i);
+	}
+	CHECK(emptied_each_time);
+#ifdef DS_ENABLE_STATS
+	CHECK(stk.get_stats().allocations == allocations);
+#endif
+
+	Stack04<string> words;
+	words.push("segmented");
+	words.push("stack");
+	string top = words.pop();
+	CHECK(top == "stack" && words.peek() == "segmented");
+
+	// A push that throws while it needs a new chunk leaves the stack as it was
+	Stack04<ThrowingMove> fragile;
+	bool caught = false;
+	try {
+		fragile.push(ThrowingMove(1, true));
+	}
+	catch (const runtime_error&) {
+		caught = true;
+	}
+	CHECK(caught && fragile.is_empty() && fragile.size() == 0);
+	fragile.push(ThrowingMove(2, false));
+	CHECK(fragile.size() == 1 && fragile.peek().value == 2);
+
+	CHECK(infix_to_postfix("a+b*(c^d-e)^(f+G*h)-i") == "abcd^e-fGh*+^*+i-");
+	CHECK(postfix_evaluation("135*+72/-") == 12.5);
+	CHECK(remove_brackets("1-(2-3-(4+5))-6-(7-8)") == "1-2+3+4+5-6-7+8");
+
+	cout << "Passed\n";
+}
+void test_concurrent_stack() {
+	cout << "\n\n***\ttest concurrent stack\t***\n\n";
+
+	// Every thread pushes its own values and pops as many: each value comes out exactly once
+	const int threads = 4, per_thread = 100000;
+	ConcurrentStack<int> shared;
+	vector<vector<int>> popped(threads);
+	vector<thread> workers;
+	for (int t = 0; t < threads; ++t)
+		workers.emplace_back([&shared, &popped, t, per_thread]() {
+			for (int i = 0; i < per_thread; ++i) {
+				shared.push(t * per_thread + i);
+				int value;
+				if (i % 2 && shared.try_pop(value))
+					popped[t].push_back(value);
+			}
+			int value;
+			while ((int)popped[t].size() < per_thread && shared.try_pop(value))
+				popped[t].push_back(value);
+		});
+	for (thread& worker : workers)
+		worker.join();
+
+	vector<int> all;
+	for (vector<int>& values : popped)
+		all.insert(all.end(), values.begin(), values.end());
+	int value;
+	while (shared.try_pop(value))
+		all.push_back(value);
+	sort(all.begin(), all.end());
+	CHECK((int)all.size() == threads * per_thread);
+	bool each_once = true;
+	for (int i = 0; i < (int)all.size(); ++i)
+		each_once = each_once && all[i] == i;
+	CHECK(each_once);
+	CHECK(shared.is_empty());
+	cout << "eliminated pairs: " << shared.eliminated_pairs() << "\n";
+
+	// Values left in the stack are destroyed with it
+	ConcurrentStack<string> words;
+	words.push("lock");
+	words.push("free");
+	string word;
+	bool got = words.try_pop(word);
+	CHECK(got && word == "free");
+
+	cout << "Passed\n";
+}
+int parallel_fib(WorkStealingPool& pool, int n) {
+	if (n < 15)
+		return n < 2 ? n : parallel_fib(pool, n - 1) + parallel_fib(pool, n - 2);
+	int a = 0, b = 0;
+	TaskGroup group(pool);
+	group.run([&pool, &a, n]() { a = parallel_fib(pool, n - 1); });
+	b = parallel_fib(pool, n - 2);
+	group.wait();
+	return a + b;
+}
+void test_work_stealing() {
+	cout << "\n\n***\ttest work stealing\t***\n\n";
+
+	// Owner pushes and pops at the bottom while three thieves steal from the top
+	WorkStealingDeque<int> deque(2);
+	const int items = 200000;
+	atomic<long long> stolen_sum(0);
+	atomic<bool> done(false);
+	vector<thread> thieves;
+	for (int t = 0; t < 3; ++t)
+		thieves.emplace_back([&deque, &stolen_sum, &done]() {
+			int item;
+			while (!done.load())
+				if (deque.steal(item))
+					stolen_sum += item;
+		});
+	long long popped_sum = 0;
+	for (int i = 1; i <= items; ++i) {
+		deque.push(i);
+		int item;
+		if (i % 3 == 0 && deque.pop(item))
+			popped_sum += item;
+	}
+	int item;
+	while (deque.pop(item))
+		popped_sum += item;
+	done = true;
+	for (thread& thief : thieves)
+		thief.join();
+	CHECK(popped_sum + stolen_sum == (long long)items * (items + 1) / 2);
+
+	// Fork-join: nested groups wait by running other jobs
+	WorkStealingPool pool(4);
+	CHECK(pool.thread_count() == 4);
+	int fib = parallel_fib(pool, 25);
+	CHECK(fib == 75025);
+
+	// Many independent jobs from outside the pool
+	vector<string> expressions;
+	for (int i = 0; i < 1000; ++i)
+		expressions.push_back(infix_to_postfix(to_string(i % 10) + "+" + to_string(i % 7) + "*3"));
+	vector<float> results(expressions.size());
+	{
+		TaskGroup group(pool);
+		for (int i = 0; i < (int)expressions.size(); ++i)
+			group.run([&expressions, &results, i]() { results[i] = postfix_evaluation(expressions[i]); });
+		group.wait();
+	}
+	bool all_evaluated = true;
+	for (int i = 0; i < (int)results.size(); ++i)
+		all_evaluated = all_evaluated && results[i] == i % 10 + (i % 7) * 3;
+	CHECK(all_evaluated);
+
+	// The first exception of a group reaches wait()
+	TaskGroup failing(pool);
+	failing.run([]() { throw runtime_error("job failed"); });
+	failing.run([]() {});
+	bool caught = false;
+	try {
+		failing.wait();
+	}
+	catch (const runtime_error&) {
+		caught = true;
+	}
+	CHECK(caught);
+
+	atomic<int> fired(0);
+	pool.submit([&fired]() { ++fired; });
+	while (fired.load() == 0)
+		this_thread::yield();
+
+	cout << "Passed\n";
+}
+void test_growable_stack() {
+	cout << "\n\n***\ttest growable stack\t***\n\n";
+
+	// No size up front: the array doubles when full
+	Stack<> stk;
+	for (int i = 0; i < 1000; ++i)
+		stk.push(i);
+	CHECK(stk.size() == 1000 && stk.capacity() >= 1000 && stk.peek() == 999);
+	stk.push(stk.peek());	// the pushed value lives in the array being replaced
+	int copy = stk.pop();
+	int original = stk.pop();
+	CHECK(copy == 999 && original == 999);
+	while (stk.size() > 10)
+		stk.pop();
+	stk.shrink_to_fit();
+	CHECK(stk.capacity() == 10 && stk.peek() == 9);
+	stk.reserve(64);
+	CHECK(stk.capacity() == 64 && stk.size() == 10);
+
+	// Move-only and non-trivial elements
+	Stack<unique_ptr<int>> owners(1);
+	owners.push(unique_ptr<int>(new int(1)));
+	owners.emplace(new int(2));
+	owners.emplace(new int(3));
+	unique_ptr<int> owner = owners.pop();
+	CHECK(*owner == 3 && *owners.peek() == 2 && owners.size() == 2);
+
+	Stack<string> words;
+	for (const char* word : { "stack", "grows", "on", "demand" })
+		words.emplace(word);
+	words.reverse();
+	string word = words.pop();
+	CHECK(word == "stack" && words.peek() == "grows");
+
+	cout << "Passed\n";
+}
+void test_stack_reverse_rotate() {
+	cout << "\n\n***\ttest stack reverse and rotate\t***\n\n";
+
+	// Deep enough to overflow the call stack with the old recursive reverse
+	const int n = 1000000;
+	Stack<> stk;
+	for (int i = 0; i < n; ++i)
+		stk.push(i);
+	stk.reverse();
+	bool reversed = true;
+	for (int i = n - 1; i >= 0; --i) {
+		int value = stk.pop();
+		reversed = reversed && value == n - 1 - i;
+	}
+	CHECK(reversed);
+
+	// Sizes around the 16-byte blocks, for both element widths
+	for (int size = 0; size < 20; ++size) {
+		Stack<> ints;
+		Stack<long long> longs;
+		for (int i = 0; i < size; ++i) {
+			ints.push(i);
+			longs.push(i);
+		}
+		ints.reverse();
+		longs.reverse();
+		bool both_reversed = true;
+		for (int i = size - 1; i >= 0; --i) {
+			int value = ints.pop();
+			long long wide = longs.pop();
+			both_reversed = both_reversed && value == size - 1 - i && wide == size - 1 - i;
+		}
+		CHECK(both_reversed);
+	}
+
+	// rotate(k): the top k go to the bottom; negative k brings the bottom up
+	int shifts[] = { 0, 1, 7, -2 };
+	int expected[][5] = {	// 1 2 3 4 5 (bottom to top) after rotate(shifts[t])
+		{ 1, 2, 3, 4, 5 },
+		{ 5, 1, 2, 3, 4 },
+		{ 4, 5, 1, 2, 3 },
+		{ 3, 4, 5, 1, 2 },
+	};
+	for (int t = 0; t < 4; ++t) {
+		Stack<> small;
+		for (int v = 1; v <= 5; ++v)
+			small.push(v);
+		small.rotate(shifts[t]);
+		bool rotated = true;
+		for (int i = 4; i >= 0; --i) {
+			int value = small.pop();
+			rotated = rotated && value == expected[t][i];
+		}
+		CHECK(rotated);
+	}
+
+	// insert_bottom: one element, then an array whose first item becomes the bottom
+	Stack<> bottom;
+	bottom.push(3);
+	bottom.insert_bottom(2);
+	int below[] = { 0, 1 };
+	bottom.insert_bottom(below, 2);
+	CHECK(bottom.size() == 4);
+	bool inserted = true;
+	for (int v = 3; v >= 0; --v) {
+		int value = bottom.pop();
+		inserted = inserted && value == v;
+	}
+	CHECK(inserted);
+
+	// Non-trivial and move-only elements take the generic path
+	Stack<string> words;
+	words.push("c");
+	string first[] = { "a", "b" };
+	words.insert_bottom(first, 2);
+	words.rotate(-1);	// a to the top
+	string top = words.pop();
+	string middle = words.pop();
+	string last = words.pop();
+	CHECK(top == "a" && middle == "c" && last == "b");
+
+	Stack<unique_ptr<int>> owners;
+	for (int v = 0; v < 5; ++v)
+		owners.emplace(new int(v));
+	owners.insert_bottom(unique_ptr<int>(new int(-1)));
+	owners.reverse();
+	unique_ptr<int> moved_up = owners.pop();
+	unique_ptr<int> next = owners.pop();
+	CHECK(*moved_up == -1 && *next == 0 && owners.size() == 4);
+
+	cout << "Passed\n";
+}
 
 int main() {
+	test_reversed_array_stack();
+	test_multi_stack();
+	test_segmented_stack();
+	test_concurrent_stack();
+	test_work_stealing();
+	test_growable_stack();
+	test_stack_reverse_rotate();
+
 	//cout << factorial_with_manual_stack(5); // 120
 
 	/* score_of_valid_parentheses Tests
@@ -1,33 +1,316 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../Common/ContainerStats.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DS_HAS_SSE2
+#endif
+
 typedef int type;
 
+/// <summary>
+/// Reverses [first, last) in place
+///
+/// 4- and 8-byte trivially copyable elements (int, float, pointers, ...) are
+/// reversed 16 bytes at a time from both ends with SSE2 shuffles; the middle
+/// and every other type go through std::reverse.
+/// </summary>
+template <typename T>
+void reverse_elements(T* first, T* last) {
+#ifdef DS_HAS_SSE2
+	if (std::is_trivially_copyable<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)) {
+		const int per_block = 16 / sizeof(T);
+		while (last - first >= 2 * per_block) {
+			__m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+			__m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last - per_block));
+			if (sizeof(T) == 4) {
+				low = _mm_shuffle_epi32(low, _MM_SHUFFLE(0, 1, 2, 3));
+				high = _mm_shuffle_epi32(high, _MM_SHUFFLE(0, 1, 2, 3));
+			}
+			else {
+				low = _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2));
+				high = _mm_shuffle_epi32(high, _MM_SHUFFLE(1, 0, 3, 2));
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(first), high);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(last - per_block), low);
+			first += per_block;
+			last -= per_block;
+		}
+	}
+#endif
+	std::reverse(first, last);
+}
+
 /// <summary>
 /// This is the basic array base stack
+///
+/// The array grows geometrically (doubling) when a push finds it full, so
+/// callers no longer size it for the worst case and push is amortised O(1).
+/// The constructor argument is only the initial capacity.
+///
+/// T may be move-only. Trivially copyable elements are moved to the new
+/// array with one memcpy; others are move constructed (copied when their
+/// move constructor may throw, so a failed growth leaves the stack as it was).
 /// </summary>
+template <typename T = type, typename Allocator = std::allocator<T>>
 class Stack {
 private:
-	type* arr{};
+	typedef std::allocator_traits<Allocator> alloc_traits;
+
+	Allocator alloc;
+	T* arr{};
 	int arr_size{};
-	int top{}; // index at the last postion or -1 if empty
+	int top = -1; // index at the last postion or -1 if empty
+	DS_STATS_MEMBER
+
+	T* allocate(int n) {
+		if (n == 0)
+			return nullptr;
+		DS_STATS_ALLOC(sizeof(T) * n);
+		return alloc_traits::allocate(alloc, n);
+	}
+
+	void deallocate(T* memory, int n) {
+		if (!memory)
+			return;
+		DS_STATS_FREE(sizeof(T) * n);
+		alloc_traits::deallocate(alloc, memory, n);
+	}
+
+	void destroy_elements() {
+		for (int i = top; i >= 0; --i)
+			alloc_traits::destroy(alloc, arr + i);
+		top = -1;
+	}
+
+	// Moves the elements into fresh (capacity new_size) and frees the old array
+	void relocate(T* fresh, int new_size) {
+		int count = top + 1;
+		if (std::is_trivially_copyable<T>::value) {
+			if (count && fresh)
+				std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(arr), sizeof(T) * count);
+		}
+		else {
+			int built = 0;
+			try {
+				for (; built < count; ++built)
+					alloc_traits::construct(alloc, fresh + built, std::move_if_noexcept(arr[built]));
+			}
+			catch (...) {
+				while (built--)
+					alloc_traits::destroy(alloc, fresh + built);
+				throw;
+			}
+			for (int i = count - 1; i >= 0; --i)
+				alloc_traits::destroy(alloc, arr + i);
+		}
+		deallocate(arr, arr_size);
+		arr = fresh;
+		arr_size = new_size;
+	}
+
+	void reallocate(int new_size) {
+		T* fresh = allocate(new_size);
+		try {
+			relocate(fresh, new_size);
+		}
+		catch (...) {
+			deallocate(fresh, new_size);
+			throw;
+		}
+	}
+
+	int grown_size() const {
+		return arr_size ? 2 * arr_size : 4;
+	}
+
 public:
-	Stack(int arr_size);
+	explicit Stack(int arr_size = 0) {
+		assert(arr_size >= 0);
+		reserve(arr_size);
+	}
+
+	~Stack() {
+		destroy_elements();
+		deallocate(arr, arr_size);
+	}
+
+	// Disable copy operations to prevent shallow copying issues
+	Stack(const Stack&) = delete;
+	Stack& operator=(const Stack&) = delete;
+
+	bool is_empty() const {
+		return top == -1;
+	}
+
+	/// <summary>
+	/// True when the array is full; the next push grows it
+	/// </summary>
+	bool is_full() const {
+		return top == arr_size - 1;
+	}
+
+	int size() const {
+		return top + 1;
+	}
+
+	int capacity() const {
+		return arr_size;
+	}
+
+	/// <summary>
+	/// Makes room for at least new_size elements without further growth
+	/// </summary>
+	void reserve(int new_size) {
+		if (new_size > arr_size)
+			reallocate(new_size);
+	}
+
+	/// <summary>
+	/// Releases the capacity above the current depth
+	/// </summary>
+	void shrink_to_fit() {
+		if (arr_size > size())
+			reallocate(size());
+	}
+
+	/// <summary>
+	/// Constructs the new top in place from args
+	/// </summary>
+	template <typename... Args>
+	T& emplace(Args&&... args) {
+		DS_STATS_OP("push");
+		if (!is_full()) {
+			alloc_traits::construct(alloc, arr + top + 1, std::forward<Args>(args)...);
+			return arr[++top];
+		}
+
+		// Build the new top first: args may refer to an element of the old array
+		int new_size = grown_size();
+		T* fresh = allocate(new_size);
+		try {
+			alloc_traits::construct(alloc, fresh + top + 1, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			deallocate(fresh, new_size);
+			throw;
+		}
+		try {
+			relocate(fresh, new_size);
+		}
+		catch (...) {
+			alloc_traits::destroy(alloc, fresh + top + 1);
+			deallocate(fresh, new_size);
+			throw;
+		}
+		return arr[++top];
+	}
+
+	void push(const T& item) {
+		emplace(item);
+	}
+
+	void push(T&& item) {
+		emplace(std::move(item));
+	}
+
+	T pop() {
+		DS_STATS_OP("pop");
+		assert(!is_empty());
+		T item = std::move(arr[top]);
+		alloc_traits::destroy(alloc, arr + top);
+		--top;
+		return item;
+	}
 
-	~Stack();
+	T& peek() {
+		assert(!is_empty());
+		return arr[top];
+	}
 
-	bool is_empty() const;
+	const T& peek() const {
+		assert(!is_empty());
+		return arr[top];
+	}
 
-	bool is_full() const;
+	/// <summary>
+	/// Moves the top k elements to the bottom, keeping their order (k < 0: the bottom -k to the top)
+	///
+	/// Three in-place reversals: O(n), no allocation, no recursion.
+	/// </summary>
+	void rotate(int k) {
+		DS_STATS_OP("rotate");
+		int n = size();
+		if (n <= 1)
+			return;
+		k %= n;
+		if (k < 0)
+			k += n;
+		if (k == 0)
+			return;
+		reverse_elements(arr, arr + n - k);
+		reverse_elements(arr + n - k, arr + n);
+		reverse_elements(arr, arr + n);
+	}
 
-	void push(type item);
+	/// <summary>
+	/// Puts x under every element, O(n)
+	/// </summary>
+	void insert_bottom(T x) {
+		DS_STATS_OP("insert_bottom");
+		push(std::move(x));
+		rotate(1);
+	}
 
-	type pop();
+	/// <summary>
+	/// Puts count elements under every element: items[0] becomes the bottom, O(n + count)
+	///
+	/// Trivially copyable elements are shifted up with one memmove; others
+	/// are pushed and rotated into place.
+	/// </summary>
+	void insert_bottom(const T* items, int count) {
+		DS_STATS_OP("insert_bottom");
+		assert(count >= 0);
+		if (count == 0)
+			return;
+		if (std::is_trivially_copyable<T>::value) {
+			int n = size();
+			if (n + count > arr_size)
+				reserve(std::max(n + count, grown_size()));
+			std::memmove(static_cast<void*>(arr + count), static_cast<const void*>(arr), sizeof(T) * n);
+			std::memcpy(static_cast<void*>(arr), static_cast<const void*>(items), sizeof(T) * count);
+			top += count;
+			return;
+		}
+		reserve(size() + count);
+		for (int i = 0; i < count; ++i)
+			push(items[i]);
+		rotate(count);
+	}
 
-	type peek() const;
+	/// <summary>
+	/// Reverses the stack in place, O(n)
+	/// </summary>
+	void reverse() {
+		DS_STATS_OP("reverse");
+		reverse_elements(arr, arr + size());
+	}
 
-	void insert_bottom(type x);
-	void reverse();
+	void display() const {
+		for (int i = top; i >= 0; --i)
+			std::cout << arr[i] << ' ';
+		std::cout << '\n';
+	}
 
-	void display() const;
+	DS_STATS_ACCESSOR
 
-};
\ No newline at end of file
+};
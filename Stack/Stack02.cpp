@@ -7,10 +7,16 @@ using std::cout;
 
 Stack02::Stack02(int arr_size) : arr_size(arr_size), added_elements(0) {
 	arr = new int[arr_size];
+	DS_STATS_ALLOC(sizeof(int) * arr_size);
 }
 
 Stack02::~Stack02() {
 	delete[] arr;
+	DS_STATS_FREE(sizeof(int) * arr_size);
+}
+
+int Stack02::top_index() const {
+	return arr_size - added_elements;
 }
 
 bool Stack02::is_empty() const {
@@ -22,28 +28,20 @@ bool Stack02::is_full() const {
 }
 
 bool Stack02::push(int item) {
+	DS_STATS_OP("push");
 	if (is_full())
 		return false;
 
-	for (int i = added_elements - 1; i >= 0; i--)
-	{
-		arr[i + 1] = arr[i];
-	}
-
-	arr[0] = item;
 	++added_elements;
+	arr[top_index()] = item;
 	return true;
 }
 
 bool Stack02::pop() {
+	DS_STATS_OP("pop");
 	if (is_empty())
 		return false;
 
-	for (int i = 0; i < added_elements - 1; i++)
-	{
-		arr[i] = arr[i + 1];
-	}
-
 	--added_elements;
 	return true;
 }
@@ -52,12 +50,20 @@ int Stack02::peek() const {
 	if (is_empty())
 		return -1;
 
-	return arr[0];
+	return arr[top_index()];
+}
+
+int Stack02::size() const {
+	return added_elements;
+}
+
+const int* Stack02::data() const {
+	return arr + top_index();
 }
 
 
 void Stack02::display()const {
-	for (int i = 0; i < added_elements; i++)
+	for (int i = top_index(); i < arr_size; i++)
 		cout << arr[i] << ' ';
 	cout << el;
 }
\ No newline at end of file
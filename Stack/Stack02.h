@@ -1,13 +1,22 @@
 #pragma once
+#include "../Common/ContainerStats.h"
 
 /// <summary>
-/// Another Stack desgin where the array[0] is the top
+/// Another Stack design that hands out its elements top first
+///
+/// The elements fill the array from the back: the stack is the slice
+/// arr[arr_size - added_elements .. arr_size - 1], read top first, so
+/// index 0 of the slice (data()[0]) is the top and nothing ever shifts.
+/// Every operation is O(1).
 /// </summary>
 class Stack02 {
 private:
 	int* arr{};
 	int arr_size{};
 	int added_elements{};
+
+	int top_index() const; // position of the top in arr
+	DS_STATS_MEMBER
 public:
 	Stack02(int arr_size);
 
@@ -23,5 +32,13 @@ public:
 
 	int peek() const;
 
+	int size() const;
+
+	/// <summary>
+	/// The elements from top to bottom: data()[0] is the top, data()[size() - 1] the bottom
+	/// </summary>
+	const int* data() const;
+
 	void display()const;
+	DS_STATS_ACCESSOR
 };
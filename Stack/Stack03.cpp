@@ -7,10 +7,12 @@ using std::cout;
 Stack03::Stack03(int arr_size) :
 	arr_size(arr_size), top1(-1), top2(arr_size) {
 	arr = new int[arr_size];
+	DS_STATS_ALLOC(sizeof(int) * arr_size);
 }
 
 Stack03::~Stack03() {
 	delete[] arr;
+	DS_STATS_FREE(sizeof(int) * arr_size);
 }
 
 bool Stack03::is_empty(int id) {
@@ -34,6 +36,7 @@ int Stack03::peek(int id) {
 }
 
 void Stack03::push(int id, int item) {
+	DS_STATS_OP("push");
 	assert(!is_full());
 
 	if (id == 1)
@@ -43,6 +46,7 @@ void Stack03::push(int id, int item) {
 }
 
 int Stack03::pop(int id) {
+	DS_STATS_OP("pop");
 	assert(!is_empty(id));
 
 	if (id == 1)
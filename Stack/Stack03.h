@@ -1,4 +1,5 @@
 #pragma once
+#include "../Common/ContainerStats.h"
 
 /// <summary>
 /// This act like two stack in one stack
@@ -20,6 +21,7 @@ private:
 	int arr_size{};
 	int top1{};
 	int top2{};
+	DS_STATS_MEMBER
 
 public:
 	Stack03(int arr_size);
@@ -37,5 +39,6 @@ public:
 	int pop(int id);
 
 	void display();
+	DS_STATS_ACCESSOR
 
 };
\ No newline at end of file
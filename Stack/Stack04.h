@@ -2,69 +2,169 @@
 
 #include <iostream>
 #include <cassert>
+#include <new>
+#include <utility>
+#include "../Common/ContainerStats.h"
 
 using std::cout;
 
 /// <summary>
-/// LinkedList based Stack
+/// Segmented Stack: a linked list of fixed-size chunks (4 KB each)
+///
+/// Elements live in arrays of chunk_capacity slots, so a push allocates
+/// only when the top chunk is full and a pop frees only when it empties one.
+/// The last emptied chunk is kept as a spare, so pushes and pops that
+/// oscillate around a chunk boundary never reach malloc.
 /// </summary>
 template <typename T>
 class Stack04 {
 private:
-	struct Node
+	static const int chunk_bytes = 4096;
+	static const int chunk_capacity = sizeof(T) + sizeof(void*) < chunk_bytes ? (int)((chunk_bytes - sizeof(void*)) / sizeof(T)) : 1;
+
+	struct Chunk
 	{
-		T data{};
-		Node* next{};
-		Node(T data) :data(data) {}
+		Chunk* below{};	///< Next chunk towards the bottom
+		alignas(T) unsigned char storage[chunk_capacity * sizeof(T)];
+
+		T* items() { return reinterpret_cast<T*>(storage); }
+		const T* items() const { return reinterpret_cast<const T*>(storage); }
 	};
 
-	Node* head;
+	Chunk* head{};		// chunk holding the top (nullptr if empty)
+	int top_count{};	// elements in head
+	Chunk* spare{};		// last emptied chunk, reused by the next push that needs one
+	int length{};
+	DS_STATS_MEMBER
+
+	Chunk* acquire_chunk()
+	{
+		if (Chunk* chunk = spare)
+		{
+			spare = nullptr;
+			return chunk;
+		}
+		DS_STATS_ALLOC(sizeof(Chunk));
+		return new Chunk;	// storage left uninitialised
+	}
+
+	void release_chunk(Chunk* chunk)
+	{
+		if (spare)
+		{
+			delete spare;
+			DS_STATS_FREE(sizeof(Chunk));
+		}
+		spare = chunk;
+	}
 
 public:
+	Stack04() {}
 
 	~Stack04()
 	{
-		while (!is_empty()) pop();
+		while (head)
+		{
+			for (int i = top_count - 1; i >= 0; --i)
+				head->items()[i].~T();
+			Chunk* below = head->below;
+			delete head;
+			DS_STATS_FREE(sizeof(Chunk));
+			head = below;
+			top_count = chunk_capacity;
+		}
+		if (spare)
+		{
+			delete spare;
+			DS_STATS_FREE(sizeof(Chunk));
+		}
 	}
 
+	// Disable copy operations to prevent shallow copying issues
+	Stack04(const Stack04&) = delete;
+	Stack04& operator=(const Stack04&) = delete;
+
 	bool is_empty()const
 	{
 		return !head;
 	}
 
+	int size()const
+	{
+		return length;
+	}
+
 	void push(T data)
 	{
-		Node* tmp = new Node(data);
-		tmp->next = head;
-		head = tmp;
+		DS_STATS_OP("push");
+		if (!head || top_count == chunk_capacity)
+		{
+			// Construct before linking, so a throwing T leaves the stack unchanged
+			Chunk* chunk = acquire_chunk();
+			try
+			{
+				new (chunk->items()) T(std::move(data));
+			}
+			catch (...)
+			{
+				release_chunk(chunk);
+				throw;
+			}
+			chunk->below = head;
+			head = chunk;
+			top_count = 1;
+		}
+		else
+		{
+			new (head->items() + top_count) T(std::move(data));
+			++top_count;
+		}
+		++length;
 	}
 
 	T pop()
 	{
+		DS_STATS_OP("pop");
 		assert(!is_empty());
 
-		T ret = head->data;
-
-		Node* del = head;
-		head = head->next;
-
-		delete del;
+		T* top = head->items() + top_count - 1;
+		T ret = std::move(*top);
+		top->~T();
+		--length;
+
+		if (--top_count == 0)
+		{
+			Chunk* emptied = head;
+			head = head->below;
+			top_count = 0;
+			if (head)
+				top_count = chunk_capacity;	// chunks below the top are full
+			release_chunk(emptied);
+		}
 
 		return ret;
 	}
 
-	T peek()const
+	T& peek()
 	{
 		assert(!is_empty());
+		return head->items()[top_count - 1];
+	}
 
-		T element = head->data;
-		return element;
+	const T& peek()const
+	{
+		assert(!is_empty());
+		return head->items()[top_count - 1];
 	}
 
+	DS_STATS_ACCESSOR
+
 	void display()const
 	{
-		for (Node* cur = head; cur; cur = cur->next)
-			cout << cur->data << " | ";
+		int count = top_count;
+		for (const Chunk* cur = head; cur; cur = cur->below, count = chunk_capacity)
+			for (int i = count - 1; i >= 0; --i)
+				cout << cur->items()[i] << " | ";
 		cout << '\n';
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// Chase–Lev work-stealing deque: the array Stack, with thieves at the other end
+///
+/// The owner thread uses it like Stack: push and pop work on the bottom of
+/// a growable circular array (LIFO, so the owner keeps running its newest,
+/// cache-hot work). Any other thread may steal from the top (FIFO, so thieves
+/// take the oldest work, usually the biggest pieces). Owner operations touch
+/// only the bottom index and do not synchronise with thieves except when one
+/// element is left; thieves race each other with one compare-and-swap on top.
+///
+/// T must be trivially copyable (typically a pointer to a task), because
+/// thieves read slots that the owner may be writing.
+///
+/// When the array is full, push copies it into one twice as large. Thieves
+/// may still be reading the old array, so old arrays are kept until the
+/// deque is destroyed (their total size is less than the current array).
+/// </summary>
+template <typename T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque needs trivially copyable elements");
+
+private:
+	struct Array
+	{
+		long long capacity;		///< Power of two
+		std::atomic<T>* slots;
+
+		explicit Array(long long capacity) :capacity(capacity), slots(new std::atomic<T>[capacity]) {}
+		~Array() { delete[] slots; }
+
+		T get(long long i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+		void put(long long i, T item) { slots[i & (capacity - 1)].store(item, std::memory_order_relaxed); }
+
+		Array* grow(long long bottom, long long top) const {
+			Array* bigger = new Array(2 * capacity);
+			for (long long i = top; i < bottom; ++i)
+				bigger->put(i, get(i));
+			return bigger;
+		}
+	};
+
+	// top and bottom on separate cache lines: thieves write one, the owner the other
+	std::atomic<long long> top{};
+	char top_padding[64 - sizeof(std::atomic<long long>)];
+	std::atomic<long long> bottom{};
+	char bottom_padding[64 - sizeof(std::atomic<long long>)];
+	std::atomic<Array*> array;
+	std::vector<Array*> retired;	// owner only
+
+public:
+	explicit WorkStealingDeque(long long capacity = 64) {
+		long long rounded = 1;
+		while (rounded < capacity)
+			rounded *= 2;
+		array.store(new Array(rounded), std::memory_order_relaxed);
+	}
+
+	~WorkStealingDeque() {
+		delete array.load();
+		for (Array* old : retired)
+			delete old;
+	}
+
+	// Disable copy operations to prevent shallow copying issues
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	/// <summary>
+	/// Snapshot of the number of elements (may be stale)
+	/// </summary>
+	long long size() const {
+		long long b = bottom.load(std::memory_order_relaxed);
+		long long t = top.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	bool is_empty() const {
+		return size() == 0;
+	}
+
+	/// <summary>
+	/// Owner only: adds at the bottom, growing the array when full
+	/// </summary>
+	void push(T item) {
+		long long b = bottom.load(std::memory_order_relaxed);
+		long long t = top.load(std::memory_order_acquire);
+		Array* a = array.load(std::memory_order_relaxed);
+		if (b - t >= a->capacity) {
+			retired.push_back(a);
+			a = a->grow(b, t);
+			array.store(a, std::memory_order_release);
+		}
+		a->put(b, item);
+		bottom.store(b + 1, std::memory_order_release);	// publishes the slot to thieves
+	}
+
+	/// <summary>
+	/// Owner only: takes the newest element; false if empty
+	/// </summary>
+	bool pop(T& out) {
+		long long b = bottom.load(std::memory_order_relaxed) - 1;
+		Array* a = array.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_seq_cst);		// claim the slot before looking at top
+		long long t = top.load(std::memory_order_seq_cst);
+
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);	// was empty
+			return false;
+		}
+		out = a->get(b);
+		if (t < b)
+			return true;	// more than one left: no thief can reach this slot
+
+		// Last element: race the thieves for it
+		bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	/// <summary>
+	/// Any thread: takes the oldest element; false if empty or another thread got it first
+	/// </summary>
+	bool steal(T& out) {
+		long long t = top.load(std::memory_order_seq_cst);
+		long long b = bottom.load(std::memory_order_seq_cst);
+		if (t >= b)
+			return false;
+
+		Array* a = array.load(std::memory_order_acquire);
+		T item = a->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+		out = item;
+		return true;
+	}
+};
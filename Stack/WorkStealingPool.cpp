@@ -0,0 +1,189 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+	// Pool and worker index of the calling thread (nullptr / -1 outside any pool)
+	thread_local const WorkStealingPool* worker_pool = nullptr;
+	thread_local int worker_index = -1;
+
+	// Rounds of stealing attempts before an idle worker goes to sleep
+	const int idle_rounds = 64;
+}
+
+//====================================================================================
+// POOL
+//====================================================================================
+
+WorkStealingPool::WorkStealingPool(int threads) {
+	if (threads <= 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (int i = 0; i < threads; ++i)
+		workers.emplace_back(new Worker());
+	// Start only once every deque exists: workers steal from all of them
+	for (int i = 0; i < threads; ++i)
+		workers[i]->thread = std::thread(&WorkStealingPool::worker_loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+	stopping.store(true);
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+	}
+	wake.notify_all();
+	for (std::unique_ptr<Worker>& worker : workers)
+		worker->thread.join();
+}
+
+int WorkStealingPool::thread_count() const {
+	return (int)workers.size();
+}
+
+int WorkStealingPool::current_worker() const {
+	return worker_pool == this ? worker_index : -1;
+}
+
+void WorkStealingPool::enqueue(Task* task) {
+	int self = current_worker();
+	if (self >= 0)
+		workers[self]->deque.push(task);
+	else {
+		std::lock_guard<std::mutex> guard(injection_lock);
+		injection.push_back(task);
+	}
+
+	// Pairs with the sleeping count a worker raises before checking queued
+	queued.fetch_add(1);
+	if (sleeping.load() > 0) {
+		{
+			std::lock_guard<std::mutex> guard(sleep_lock);
+		}
+		wake.notify_one();
+	}
+}
+
+WorkStealingPool::Task* WorkStealingPool::find_task(int self) {
+	Task* task = nullptr;
+	if (self >= 0 && workers[self]->deque.pop(task)) {
+		queued.fetch_sub(1);
+		return task;
+	}
+
+	// Steal, starting at a different victim for every thief
+	int count = (int)workers.size();
+	int start = self >= 0 ? self + 1 : 0;
+	for (int i = 0; i < count; ++i) {
+		int victim = (start + i) % count;
+		if (victim != self && workers[victim]->deque.steal(task)) {
+			queued.fetch_sub(1);
+			return task;
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(injection_lock);
+	if (injection.empty())
+		return nullptr;
+	task = injection.front();
+	injection.pop_front();
+	queued.fetch_sub(1);
+	return task;
+}
+
+void WorkStealingPool::execute(Task* task) {
+	std::unique_ptr<Task> owned(task);
+	if (!task->group) {
+		task->job();	// an exception here reaches the thread boundary and terminates
+		return;
+	}
+
+	std::exception_ptr job_error;
+	try {
+		task->job();
+	}
+	catch (...) {
+		job_error = std::current_exception();
+	}
+	task->group->finish(job_error);
+}
+
+void WorkStealingPool::worker_loop(int index) {
+	worker_pool = this;
+	worker_index = index;
+
+	int idle = 0;
+	while (true) {
+		if (Task* task = find_task(index)) {
+			execute(task);
+			idle = 0;
+			continue;
+		}
+		if (stopping.load() && queued.load() == 0)
+			break;
+		if (++idle < idle_rounds) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_lock);
+		sleeping.fetch_add(1);
+		wake.wait(lock, [this] { return queued.load() > 0 || stopping.load(); });
+		sleeping.fetch_sub(1);
+		idle = 0;
+	}
+}
+
+void WorkStealingPool::submit(std::function<void()> job) {
+	enqueue(new Task{ std::move(job), nullptr });
+}
+
+bool WorkStealingPool::run_pending_task() {
+	Task* task = find_task(current_worker());
+	if (!task)
+		return false;
+	execute(task);
+	return true;
+}
+
+//====================================================================================
+// TASK GROUP
+//====================================================================================
+
+TaskGroup::TaskGroup(WorkStealingPool& pool) :pool(pool) {}
+
+TaskGroup::~TaskGroup() {
+	help_until_done();
+}
+
+void TaskGroup::run(std::function<void()> job) {
+	pending.fetch_add(1, std::memory_order_relaxed);
+	pool.enqueue(new WorkStealingPool::Task{ std::move(job), this });
+}
+
+void TaskGroup::finish(std::exception_ptr job_error) {
+	if (job_error) {
+		std::lock_guard<std::mutex> guard(error_lock);
+		if (!error)
+			error = job_error;
+	}
+	pending.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskGroup::help_until_done() {
+	// The jobs may be queued behind others: run those instead of blocking
+	while (pending.load(std::memory_order_acquire) > 0)
+		if (!pool.run_pending_task())
+			std::this_thread::yield();
+}
+
+void TaskGroup::wait() {
+	help_until_done();
+	std::exception_ptr first;
+	{
+		std::lock_guard<std::mutex> guard(error_lock);
+		first = error;
+		error = nullptr;
+	}
+	if (first)
+		std::rethrow_exception(first);
+}
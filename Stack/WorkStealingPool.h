@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "WorkStealingDeque.h"
+
+class TaskGroup;
+
+/// <summary>
+/// Thread pool where every worker has its own WorkStealingDeque
+///
+/// A job submitted from a worker goes to the bottom of that worker's deque
+/// and is usually run by the same worker (no shared queue, no lock). Idle
+/// workers steal from the top of a random other worker's deque. Jobs from
+/// threads outside the pool go through one locked injection queue.
+/// Workers that find nothing sleep until new work arrives.
+///
+/// Fork-join goes through TaskGroup: a task may start sub-tasks and wait
+/// for them, and the waiting thread runs pending jobs meanwhile instead of
+/// blocking, so nested waits cannot starve the pool.
+/// </summary>
+class WorkStealingPool {
+private:
+	struct Task
+	{
+		std::function<void()> job;
+		TaskGroup* group{};		///< nullptr for submit()
+	};
+
+	struct Worker
+	{
+		WorkStealingDeque<Task*> deque;
+		std::thread thread;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::mutex injection_lock;
+	std::deque<Task*> injection;		// jobs from threads outside the pool
+	std::mutex sleep_lock;
+	std::condition_variable wake;
+	std::atomic<int> queued{};			// jobs waiting in a deque or the injection queue
+	std::atomic<int> sleeping{};
+	std::atomic<bool> stopping{};
+
+	void enqueue(Task* task);
+
+	/// <summary>
+	/// Own deque first, then steal, then the injection queue; nullptr if nothing is queued
+	/// </summary>
+	Task* find_task(int self);
+
+	void execute(Task* task);
+
+	void worker_loop(int index);
+
+	// Index of the calling thread among this pool's workers (-1 for other threads)
+	int current_worker() const;
+
+	friend class TaskGroup;
+
+public:
+	/// <summary>
+	/// Starts the workers (threads = 0: one per hardware thread)
+	/// </summary>
+	explicit WorkStealingPool(int threads = 0);
+
+	/// <summary>
+	/// Runs every queued job, then stops and joins the workers
+	/// </summary>
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	int thread_count() const;
+
+	/// <summary>
+	/// Queues a job nobody waits for (an exception escaping it terminates the program)
+	/// </summary>
+	void submit(std::function<void()> job);
+
+	/// <summary>
+	/// Runs one queued job on the calling thread; false if none was found
+	/// </summary>
+	bool run_pending_task();
+};
+
+/// <summary>
+/// Jobs that are waited for together (fork-join)
+///
+/// @code
+/// int fib(WorkStealingPool& pool, int n) {
+///     if (n < 2) return n;
+///     int a, b;
+///     TaskGroup group(pool);
+///     group.run([&] { a = fib(pool, n - 1); });
+///     b = fib(pool, n - 2);
+///     group.wait();
+///     return a + b;
+/// }
+/// @endcode
+/// </summary>
+class TaskGroup {
+private:
+	WorkStealingPool& pool;
+	std::atomic<int> pending{};
+	std::mutex error_lock;
+	std::exception_ptr error;	// first exception thrown by a job
+
+	void finish(std::exception_ptr job_error);
+	void help_until_done();
+
+	friend class WorkStealingPool;
+
+public:
+	explicit TaskGroup(WorkStealingPool& pool);
+
+	/// <summary>
+	/// Waits for the jobs still running (their exceptions are dropped)
+	/// </summary>
+	~TaskGroup();
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	void run(std::function<void()> job);
+
+	/// <summary>
+	/// Runs queued jobs until every job of the group finished, then rethrows the first exception
+	/// </summary>
+	void wait();
+};